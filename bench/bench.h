@@ -0,0 +1,55 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "models.h"
+
+namespace bench {
+// Best wall time of `run` in milliseconds over `repeats` runs. `setup` runs
+// before each one and is not timed, so inputs can be rebuilt between runs.
+template <typename Setup, typename Run>
+double bestOfMs(int repeats, Setup setup, Run run) {
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < repeats; i++) {
+        setup();
+        auto start = std::chrono::steady_clock::now();
+        run();
+        std::chrono::duration<double, std::milli> elapsed =
+            std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+template <typename Run>
+double bestOfMs(int repeats, Run run) {
+    return bestOfMs(repeats, [] {}, run);
+}
+
+// Open tasks shaped like real rows: priority 1-4, a due date within a year,
+// ids in insertion order and a short title.
+inline std::vector<Task> randomTasks(std::size_t count, unsigned seed = 1) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> priority(1, 4);
+    std::uniform_int_distribution<std::time_t> due(0, 365 * 24 * 3600);
+
+    std::vector<Task> tasks(count);
+    for (std::size_t i = 0; i < count; i++) {
+        tasks[i].id = static_cast<int>(i + 1);
+        tasks[i].title = "Task " + std::to_string(i + 1);
+        tasks[i].priority = priority(rng);
+        tasks[i].status = 0;
+        tasks[i].dueDate = due(rng);
+        tasks[i].creationTime = static_cast<std::time_t>(i);
+    }
+    return tasks;
+}
+
+}  // namespace bench
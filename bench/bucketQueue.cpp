@@ -0,0 +1,60 @@
+// Binary heap (core::Queue) vs per-priority buckets (core::BucketQueue).
+//
+// "next" is what `task next` does: load every ready task, take the best one.
+// "drain" extracts every task, which is what a dispatcher would do. The last
+// column is heap time divided by bucket time, so values above 1 mean the
+// bucket queue is ahead at that size.
+
+#include <print>
+#include <vector>
+
+#include "BucketQueue.h"
+#include "PriorityQueue.h"
+#include "bench.h"
+
+namespace {
+template <typename QueueType>
+double timeNext(const std::vector<Task>& tasks, int repeats) {
+    return bench::bestOfMs(repeats, [&] {
+        QueueType queue;
+        for (const auto& task : tasks) {
+            queue.insert(task);
+        }
+        queue.extractMin();
+    });
+}
+
+template <typename QueueType>
+double timeDrain(const std::vector<Task>& tasks, int repeats) {
+    return bench::bestOfMs(repeats, [&] {
+        QueueType queue;
+        for (const auto& task : tasks) {
+            queue.insert(task);
+        }
+        while (queue.extractMin()) {
+        }
+    });
+}
+}  // namespace
+
+int main() {
+    std::println("{:>9} {:>12} {:>12} {:>6} {:>12} {:>12} {:>6}", "tasks",
+                 "heap next", "bucket next", "ratio", "heap drain",
+                 "bucket drain", "ratio");
+
+    for (std::size_t count = 16; count <= (1u << 20); count *= 4) {
+        auto tasks = bench::randomTasks(count);
+        int repeats = count <= 4096 ? 200 : 5;
+
+        double heapNext = timeNext<core::Queue>(tasks, repeats);
+        double bucketNext = timeNext<core::BucketQueue>(tasks, repeats);
+        double heapDrain = timeDrain<core::Queue>(tasks, repeats);
+        double bucketDrain = timeDrain<core::BucketQueue>(tasks, repeats);
+
+        std::println("{:>9} {:>10.3f}ms {:>10.3f}ms {:>6.2f} {:>10.3f}ms "
+                     "{:>10.3f}ms {:>6.2f}",
+                     count, heapNext, bucketNext, heapNext / bucketNext,
+                     heapDrain, bucketDrain, heapDrain / bucketDrain);
+    }
+    return 0;
+}
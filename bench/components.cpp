@@ -0,0 +1,126 @@
+// Critical path computed in place vs split into weakly connected components
+// across a core::ThreadPool. Graphs are islands of tasks, each task waiting
+// on up to three earlier tasks of its island.
+//
+// "split cost" is what the split pays before any analysis runs: union-find,
+// packing and copying out the subgraphs. The in-place columns time one
+// thread running core::computeCpm, DependencyGraph::waves and
+// DependencyGraph::cyclicComponents. "forced" times the split CPM at each
+// pool size with the thresholds bypassed. "auto" uses the thresholds on a
+// pool sized to the hardware, as cascade does.
+
+#include <cstdint>
+#include <memory>
+#include <print>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DependencyGraph.h"
+#include "ThreadPool.h"
+#include "bench.h"
+#include "components.h"
+#include "cpm.h"
+#include "models.h"
+
+namespace {
+struct Shape {
+    int islands;
+    int islandSize;
+};
+
+core::DependencyGraph islandGraph(const Shape& shape) {
+    std::mt19937 rng(2);
+    std::vector<int> ids;
+    std::vector<Dependency> edges;
+    for (int island = 0; island < shape.islands; island++) {
+        int first = island * shape.islandSize + 1;
+        for (int i = 0; i < shape.islandSize; i++) {
+            ids.push_back(first + i);
+            for (int j = 0; j < 3 && i > 0; j++) {
+                int prerequisite = first + static_cast<int>(rng() % i);
+                edges.push_back({first + i, prerequisite});
+            }
+        }
+    }
+    return core::DependencyGraph(std::move(ids), edges);
+}
+
+double splitCost(const core::DependencyGraph& graph, std::size_t parts,
+                 int repeats) {
+    return bench::bestOfMs(repeats, [&] {
+        auto split = core::partitionComponents(graph, parts);
+        std::vector<std::uint32_t> localIndex(graph.getVertexCount());
+        for (const auto& part : split) {
+            for (std::size_t i = 0; i < part.size(); i++) {
+                localIndex[part[i]] = static_cast<std::uint32_t>(i);
+            }
+        }
+        for (const auto& part : split) {
+            graph.subgraph(part, localIndex);
+        }
+    });
+}
+}  // namespace
+
+int main() {
+    unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 2; threads <= std::max(hardware, 4u);
+         threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    std::vector<std::unique_ptr<core::ThreadPool>> pools;
+    for (unsigned threads : threadCounts) {
+        pools.push_back(std::make_unique<core::ThreadPool>(threads));
+    }
+    core::ThreadPool single(1);
+    core::ThreadPool hardwarePool(hardware);
+
+    std::println("hardware threads: {}", hardware);
+    std::print("{:<12} {:>7} {:>10} | {:>8} {:>8} {:>8} | forced cpm",
+               "islands", "V+E", "split cost", "cpm", "waves", "cycles");
+    for (unsigned threads : threadCounts) {
+        std::print(" {:>8}", std::to_string(threads) + "t");
+    }
+    std::println(" | {:>8}", "auto");
+
+    for (Shape shape : {Shape{1, 200000}, Shape{20, 10000}, Shape{2000, 100},
+                        Shape{200, 100}, Shape{20, 100}}) {
+        auto graph = islandGraph(shape);
+        std::string name = std::to_string(shape.islands) + " x " +
+                           std::to_string(shape.islandSize);
+        std::size_t work = graph.getVertexCount() + graph.getEdgeCount();
+        int repeats = work < 100000 ? 50 : 5;
+
+        std::vector<std::int64_t> durations(graph.getVertexCount());
+        std::mt19937 rng(3);
+        for (auto& duration : durations) {
+            duration = 1 + static_cast<std::int64_t>(rng() % 8);
+        }
+        auto cpm = [&](core::ThreadPool& pool) {
+            return bench::bestOfMs(repeats, [&] {
+                core::computeCpm(graph, durations, pool);
+            });
+        };
+
+        std::print(
+            "{:<12} {:>7} {:>8.2f}ms | {:>6.2f}ms {:>6.2f}ms {:>6.2f}ms |", name,
+            work,
+            splitCost(graph, core::PARTS_PER_THREAD * threadCounts.back(),
+                      repeats),
+            cpm(single),
+            bench::bestOfMs(repeats, [&] { graph.waves(single); }),
+            bench::bestOfMs(repeats, [&] { graph.cyclicComponents(); }));
+        std::print("{:>10}", "");
+
+        core::setComponentSplitForced(true);
+        for (auto& pool : pools) {
+            std::print(" {:>6.2f}ms", cpm(*pool));
+        }
+        core::setComponentSplitForced(false);
+        std::println(" | {:>6.2f}ms", cpm(hardwarePool));
+    }
+    return 0;
+}
@@ -0,0 +1,147 @@
+// `deps show --depth N`: db::getNeighbourhood's recursive CTE vs loading the
+// whole graph and walking it in memory, which is what answering from a
+// core::DependencyGraph would cost. The graph is 200,000 tasks, each waiting
+// on three tasks among the 1,000 before it, written to a fresh database next
+// to this binary.
+//
+// Both columns are milliseconds per query, averaged over the same start
+// tasks and alternating direction. The full-graph column covers fetching
+// every task and edge, building the graph, and a breadth-first walk to the
+// depth bound; the ratio is that time over the CTE's.
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <print>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "DependencyGraph.h"
+#include "SQLiteCpp/Statement.h"
+#include "SQLiteCpp/Transaction.h"
+#include "bench.h"
+#include "database.h"
+#include "models.h"
+
+namespace {
+constexpr int TASK_COUNT = 200000;
+constexpr int WINDOW = 1000;
+
+void fillDatabase() {
+    auto& db = db::getConnection();
+    SQLite::Transaction transaction(db);
+    SQLite::Statement insertTask(
+        db,
+        "INSERT INTO tasks (title, priority, status, dueDate, creationTime) "
+        "VALUES (?, 2, 0, 0, 0)");
+    for (int id = 1; id <= TASK_COUNT; id++) {
+        insertTask.bind(1, "Task " + std::to_string(id));
+        insertTask.exec();
+        insertTask.reset();
+    }
+
+    std::mt19937 rng(8);
+    SQLite::Statement insertEdge(
+        db,
+        "INSERT OR IGNORE INTO task_dependencies (task_id, depends_on) "
+        "VALUES (?, ?)");
+    for (int id = 2; id <= TASK_COUNT; id++) {
+        int window = std::min(id - 1, WINDOW);
+        for (int j = 0; j < 3; j++) {
+            insertEdge.bind(1, id);
+            insertEdge.bind(2, id - 1 - static_cast<int>(rng() % window));
+            insertEdge.exec();
+            insertEdge.reset();
+        }
+    }
+    transaction.commit();
+}
+
+std::vector<TaskAtDepth> fullGraphNeighbourhood(int taskId,
+                                                ReachDirection direction,
+                                                int maxDepth) {
+    auto tasks = db::getTasksByUser();
+    auto edges = db::getDependencies();
+    std::vector<int> ids;
+    ids.reserve(tasks.size());
+    for (const auto& task : tasks) {
+        ids.push_back(task.id);
+    }
+    core::DependencyGraph graph(std::move(ids), edges);
+
+    // Rows arrive in id order, and graph vertices are the sorted ids
+    std::vector<int> depth(graph.getVertexCount(), -1);
+    std::vector<std::uint32_t> frontier{*graph.indexOf(taskId)};
+    depth[frontier[0]] = 0;
+    std::vector<TaskAtDepth> found;
+    for (int level = 1; level <= maxDepth && !frontier.empty(); level++) {
+        std::vector<std::uint32_t> next;
+        for (std::uint32_t vertex : frontier) {
+            auto neighbours = direction == ReachDirection::Downstream
+                                  ? graph.dependents(vertex)
+                                  : graph.prerequisites(vertex);
+            for (std::uint32_t neighbour : neighbours) {
+                if (depth[neighbour] < 0) {
+                    depth[neighbour] = level;
+                    next.push_back(neighbour);
+                    found.push_back({tasks[neighbour], level});
+                }
+            }
+        }
+        frontier = std::move(next);
+    }
+    return found;
+}
+}  // namespace
+
+int main() {
+    std::filesystem::remove(DATABASE_FILE);
+    db::initDatabase();
+    fillDatabase();
+    std::println("{} tasks, {} edges", TASK_COUNT,
+                 db::getDependencies().size());
+
+    std::vector<int> starts{TASK_COUNT / 5, TASK_COUNT / 3, TASK_COUNT / 2,
+                            TASK_COUNT * 2 / 3, TASK_COUNT * 4 / 5};
+    auto direction = [](std::size_t i) {
+        return i % 2 == 0 ? ReachDirection::Downstream
+                          : ReachDirection::Upstream;
+    };
+
+    std::println("{:>5} {:>9} {:>11} {:>11} {:>8}", "depth", "found",
+                 "cte", "full graph", "ratio");
+    for (int depth : {1, 2, 3, 4, 6}) {
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < starts.size(); i++) {
+            auto cte = db::getNeighbourhood(starts[i], direction(i), depth);
+            auto full = fullGraphNeighbourhood(starts[i], direction(i), depth);
+            if (cte.size() != full.size()) {
+                std::println("depth {}: the two walks disagree", depth);
+                return 1;
+            }
+            found += cte.size();
+        }
+
+        double queries = static_cast<double>(starts.size());
+        double cteMs = bench::bestOfMs(20, [&] {
+                           for (std::size_t i = 0; i < starts.size(); i++) {
+                               db::getNeighbourhood(starts[i], direction(i),
+                                                    depth);
+                           }
+                       }) /
+                       queries;
+        double fullMs = bench::bestOfMs(1, [&] {
+                            for (std::size_t i = 0; i < starts.size(); i++) {
+                                fullGraphNeighbourhood(starts[i],
+                                                       direction(i), depth);
+                            }
+                        }) /
+                        queries;
+        std::println("{:>5} {:>9.1f} {:>9.3f}ms {:>9.1f}ms {:>8.0f}", depth,
+                     static_cast<double>(found) / queries, cteMs, fullMs,
+                     fullMs / cteMs);
+    }
+    std::filesystem::remove(DATABASE_FILE);
+    return 0;
+}
@@ -0,0 +1,61 @@
+// core::sortedOrder on a title spec with one worker vs a pool. Title specs
+// cannot be packed into integers, so they take the adaptive merge sort over
+// row indices, and that is the path split across the pool: each worker
+// sorts one chunk, then merges are cut into slices per worker. Titles are
+// shuffled so the input has no natural runs to exploit. Times include
+// building the natural title keys, which stays on the calling thread.
+
+#include <algorithm>
+#include <memory>
+#include <print>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ThreadPool.h"
+#include "bench.h"
+#include "sortspec.h"
+
+int main() {
+    unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 2; threads <= std::max(hardware, 4u);
+         threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    std::vector<std::unique_ptr<core::ThreadPool>> pools;
+    for (unsigned threads : threadCounts) {
+        pools.push_back(std::make_unique<core::ThreadPool>(threads));
+    }
+    core::ThreadPool single(1);
+    auto spec = core::parseSortSpec("title,-priority").value();
+
+    std::println("hardware threads: {}", hardware);
+    std::print("{:>9} {:>9}", "tasks", "1t");
+    for (unsigned threads : threadCounts) {
+        std::print(" {:>9} {:>6}", std::to_string(threads) + "t", "ratio");
+    }
+    std::println();
+
+    for (std::size_t count : {16384uz, 65536uz, 262144uz, 1048576uz}) {
+        auto tasks = bench::randomTasks(count);
+        std::mt19937 rng(4);
+        std::shuffle(tasks.begin(), tasks.end(), rng);
+        int repeats = count <= 65536 ? 20 : 3;
+
+        auto timeSort = [&](core::ThreadPool& pool) {
+            return bench::bestOfMs(
+                repeats, [&] { core::sortedOrder(tasks, spec, pool); });
+        };
+
+        double singleMs = timeSort(single);
+        std::print("{:>9} {:>7.2f}ms", count, singleMs);
+        for (auto& pool : pools) {
+            double poolMs = timeSort(*pool);
+            std::print(" {:>7.2f}ms {:>6.2f}", poolMs, singleMs / poolMs);
+        }
+        std::println();
+    }
+    return 0;
+}
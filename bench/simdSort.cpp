@@ -0,0 +1,69 @@
+// core::sortPacked with the AVX2 leaf kernels vs the scalar ones. Values are
+// packed like a priority,due spec: a 32-bit key (2 bits of priority over
+// about a year of due dates in minutes) above the row index. MSD radix
+// passes split the input into leaves of at most 256 values, and the kernels
+// sort those. Inputs under 2048 values skip both and use std::sort, which is
+// also the reference column.
+
+#include <algorithm>
+#include <cstdint>
+#include <print>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "bench.h"
+#include "simdSort.h"
+
+namespace {
+std::vector<std::uint64_t> packedValues(std::size_t count) {
+    std::mt19937_64 rng(1);
+    std::uniform_int_distribution<std::uint64_t> priority(0, 3);
+    std::uniform_int_distribution<std::uint64_t> due(0, 366 * 24 * 60);
+
+    std::vector<std::uint64_t> values(count);
+    for (std::size_t row = 0; row < count; row++) {
+        std::uint64_t key = priority(rng) << 30 | due(rng);
+        values[row] = key << 32 | row;
+    }
+    return values;
+}
+
+double timeSort(const std::vector<std::uint64_t>& input, bool simd) {
+    core::setSimdSortEnabled(simd);
+    std::vector<std::uint64_t> values;
+    int repeats = input.size() <= 4096 ? 2000 : 5;
+    return bench::bestOfMs(
+        repeats, [&] { values = input; },
+        [&] { core::sortPacked(std::span<std::uint64_t>(values)); });
+}
+}  // namespace
+
+int main() {
+    core::setSimdSortEnabled(true);
+    if (!core::hasSimdSort()) {
+        std::println("This CPU has no AVX2; both columns use scalar kernels.");
+    }
+
+    std::println("{:>9} {:>11} {:>11} {:>6} {:>11}", "values", "avx2",
+                 "scalar", "ratio", "std::sort");
+
+    for (std::size_t count :
+         {1024uz, 2048uz, 4096uz, 16384uz, 65536uz, 1048576uz}) {
+        auto input = packedValues(count);
+        double simdMs = timeSort(input, true);
+        double scalarMs = timeSort(input, false);
+
+        std::vector<std::uint64_t> values;
+        double stdMs = bench::bestOfMs(
+            count <= 4096 ? 2000 : 5, [&] { values = input; },
+            [&] { std::sort(values.begin(), values.end()); });
+
+        double perElement = 1e6 / static_cast<double>(count);
+        std::println("{:>9} {:>9.1f}ns {:>9.1f}ns {:>6.2f} {:>9.1f}ns", count,
+                     simdMs * perElement, scalarMs * perElement,
+                     scalarMs / simdMs, stdMs * perElement);
+    }
+    core::setSimdSortEnabled(true);
+    return 0;
+}
@@ -0,0 +1,137 @@
+// DependencyGraph::waves, Kahn's algorithm with atomic in-degrees spread
+// over a core::ThreadPool, vs plain sequential Kahn one level at a time.
+// Graphs are layers of tasks, each task waiting on four tasks of the layer
+// before it, so every graph has about 1M edges and as many waves as layers.
+//
+// "sequential" uses plain counters and no pool. "1t" is the atomic version
+// on one worker, so the gap between them is the cost of the atomics. The
+// remaining columns add workers; a frontier is only split once it holds
+// more than a grain of 1024 tasks, so narrow graphs stay on one thread.
+// Each ratio is sequential time divided by pool time, so values above 1
+// mean the pool is ahead.
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <print>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DependencyGraph.h"
+#include "ThreadPool.h"
+#include "bench.h"
+#include "models.h"
+
+namespace {
+struct Shape {
+    int layers;
+    int width;
+};
+
+core::DependencyGraph layeredGraph(const Shape& shape) {
+    std::mt19937 rng(6);
+    std::vector<int> ids;
+    std::vector<Dependency> edges;
+    for (int layer = 0; layer < shape.layers; layer++) {
+        for (int i = 0; i < shape.width; i++) {
+            int id = layer * shape.width + i + 1;
+            ids.push_back(id);
+            for (int j = 0; j < 4 && layer > 0; j++) {
+                int prerequisite = (layer - 1) * shape.width +
+                                   static_cast<int>(rng() % shape.width) + 1;
+                edges.push_back({id, prerequisite});
+            }
+        }
+    }
+    return core::DependencyGraph(std::move(ids), edges);
+}
+
+std::optional<std::vector<std::vector<std::uint32_t>>> sequentialWaves(
+    const core::DependencyGraph& graph) {
+    std::size_t vertexCount = graph.getVertexCount();
+    std::vector<std::uint32_t> inDegree(vertexCount);
+    std::vector<std::uint32_t> frontier;
+    for (std::uint32_t v = 0; v < vertexCount; v++) {
+        inDegree[v] = static_cast<std::uint32_t>(graph.prerequisites(v).size());
+        if (inDegree[v] == 0) {
+            frontier.push_back(v);
+        }
+    }
+
+    std::vector<std::vector<std::uint32_t>> result;
+    std::size_t emitted = 0;
+    while (!frontier.empty()) {
+        std::vector<std::uint32_t> next;
+        for (std::uint32_t v : frontier) {
+            for (std::uint32_t dependent : graph.dependents(v)) {
+                if (--inDegree[dependent] == 0) {
+                    next.push_back(dependent);
+                }
+            }
+        }
+        emitted += frontier.size();
+        result.push_back(std::move(frontier));
+        frontier = std::move(next);
+    }
+
+    if (emitted != vertexCount) {
+        return std::nullopt;
+    }
+    return result;
+}
+}  // namespace
+
+int main() {
+    unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 2; threads <= std::max(hardware, 4u);
+         threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    std::vector<std::unique_ptr<core::ThreadPool>> pools;
+    for (unsigned threads : threadCounts) {
+        pools.push_back(std::make_unique<core::ThreadPool>(threads));
+    }
+    core::ThreadPool single(1);
+
+    std::println("hardware threads: {}", hardware);
+    std::print("{:<14} {:>8} {:>10} {:>10}", "layers x width", "edges",
+               "sequential", "1t");
+    for (unsigned threads : threadCounts) {
+        std::print(" {:>10} {:>6}", std::to_string(threads) + "t", "ratio");
+    }
+    std::println();
+
+    for (Shape shape : {Shape{10, 25000}, Shape{100, 2500}, Shape{1000, 250},
+                        Shape{10000, 25}}) {
+        auto graph = layeredGraph(shape);
+        std::string name = std::to_string(shape.layers) + " x " +
+                           std::to_string(shape.width);
+
+        // Both versions must agree on how many tasks each wave holds
+        auto expected = sequentialWaves(graph);
+        auto actual = graph.waves(single);
+        bool same = expected && actual && expected->size() == actual->size();
+        for (std::size_t wave = 0; same && wave < expected->size(); wave++) {
+            same = (*expected)[wave].size() == (*actual)[wave].size();
+        }
+        if (!same) {
+            std::println("{:<14} waves differ", name);
+            return 1;
+        }
+
+        double sequentialMs =
+            bench::bestOfMs(5, [&] { sequentialWaves(graph); });
+        std::print("{:<14} {:>8} {:>8.2f}ms {:>8.2f}ms", name,
+                   graph.getEdgeCount(), sequentialMs,
+                   bench::bestOfMs(5, [&] { graph.waves(single); }));
+        for (auto& pool : pools) {
+            double poolMs = bench::bestOfMs(5, [&] { graph.waves(*pool); });
+            std::print(" {:>8.2f}ms {:>6.2f}", poolMs, sequentialMs / poolMs);
+        }
+        std::println();
+    }
+    return 0;
+}
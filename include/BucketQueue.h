@@ -0,0 +1,40 @@
+#pragma once
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include "models.h"
+
+namespace core {
+// Drop-in alternative to core::Queue exploiting the 1-4 priority domain: one
+// due-date heap per priority level plus an occupancy bitmask, so locating the
+// minimum is a single bit scan and inserts are deferred until the next read.
+class BucketQueue {
+   public:
+    void insert(Task task);
+    std::optional<Task> extractMin();
+    std::optional<Task> peek();
+    bool isEmpty();
+    int getSize();
+
+   private:
+    static constexpr int BUCKET_COUNT = 4;
+
+    struct Bucket {
+        std::vector<Task> heap;
+        // heap[0, settled) satisfies the heap property, the rest are pending
+        std::size_t settled = 0;
+    };
+
+    std::array<Bucket, BUCKET_COUNT> buckets;
+    unsigned occupied = 0;
+    int size = 0;
+
+    static int bucketIndex(int priority);
+
+    Bucket* firstBucket();
+    static void settle(Bucket& bucket);
+};
+
+}  // namespace core
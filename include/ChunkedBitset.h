@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "models.h"
+
+namespace core {
+// Sparse bitset: only chunks holding a set bit are allocated, so a small
+// reachability set over a large slot range stays small.
+class ChunkedBitset {
+   public:
+    ChunkedBitset() = default;
+    explicit ChunkedBitset(const std::vector<ReachChunk>& stored);
+
+    std::vector<ReachChunk> toChunks() const;
+
+    void set(std::uint32_t bit);
+    bool test(std::uint32_t bit) const;
+    // Returns true if any bit was added
+    bool unionWith(const ChunkedBitset& other);
+    std::size_t count() const;
+
+    template <class Visit>
+    void forEach(Visit visit) const;
+
+    bool operator==(const ChunkedBitset& other) const = default;
+
+   private:
+    static constexpr std::size_t CHUNK_WORDS = REACH_CHUNK_BITS / 64;
+    using Chunk = std::array<std::uint64_t, CHUNK_WORDS>;
+
+    std::map<std::uint32_t, Chunk> chunks;
+};
+
+template <class Visit>
+void ChunkedBitset::forEach(Visit visit) const {
+    for (const auto& [index, chunk] : chunks) {
+        for (std::size_t w = 0; w < CHUNK_WORDS; w++) {
+            std::uint32_t base = index * REACH_CHUNK_BITS + w * 64;
+            for (std::uint64_t word = chunk[w]; word != 0; word &= word - 1) {
+                visit(base + std::countr_zero(word));
+            }
+        }
+    }
+}
+
+}  // namespace core
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <span>
+#include <vector>
+
+#include "ThreadPool.h"
+#include "models.h"
+
+namespace core {
+// Task dependencies in compressed sparse row form. Vertices are dense
+// indices over the sorted task ids; the dependents of vertex v are
+// forwardTargets[forwardOffsets[v], forwardOffsets[v + 1]), and the reverse
+// arrays hold prerequisites the same way, so a traversal in either
+// direction reads contiguous memory.
+class DependencyGraph {
+   public:
+    // Edges naming an id outside taskIds are dropped.
+    DependencyGraph(std::vector<int> taskIds,
+                    std::span<const Dependency> edges);
+    // Vertices are exactly the tasks that appear in some edge.
+    static DependencyGraph fromEdges(std::span<const Dependency> edges);
+
+    std::size_t getVertexCount() const;
+    std::size_t getEdgeCount() const;
+
+    std::optional<std::uint32_t> indexOf(int taskId) const;
+    int taskIdAt(std::uint32_t vertex) const;
+
+    // Induced subgraph over sorted `vertices`, which must include every
+    // neighbour of each of them (e.g. whole weakly connected components).
+    // Its vertex i is this graph's vertices[i], and localIndex[v] must give
+    // that i for each v, so the arrays are copied without any search.
+    DependencyGraph subgraph(std::span<const std::uint32_t> vertices,
+                             std::span<const std::uint32_t> localIndex) const;
+
+    std::span<const std::uint32_t> dependents(std::uint32_t vertex) const;
+    std::span<const std::uint32_t> prerequisites(std::uint32_t vertex) const;
+
+    // True if `to` can be reached from `from` by following dependents.
+    bool reaches(std::uint32_t from, std::uint32_t to) const;
+
+    // Kahn's algorithm; among ready vertices the one ordered first by
+    // `before` goes next. Returns nullopt if the graph has a cycle.
+    template <class Compare>
+    std::optional<std::vector<std::uint32_t>> topologicalOrder(
+        Compare before) const;
+    std::optional<std::vector<std::uint32_t>> topologicalOrder() const;
+
+    // Kahn's algorithm one level at a time: each wave holds the vertices
+    // whose prerequisites all lie in earlier waves, so a wave's tasks can
+    // run concurrently. Returns nullopt if the graph has a cycle.
+    std::optional<std::vector<std::vector<std::uint32_t>>> waves(
+        ThreadPool& pool) const;
+
+    // Strongly connected components with more than one vertex, each a set
+    // of tasks that transitively wait on each other, sorted by vertex.
+    // Pearce's variant of Tarjan's algorithm over an explicit stack, so a
+    // long chain cannot overflow the call stack; linear in V + E.
+    std::vector<std::vector<std::uint32_t>> cyclicComponents() const;
+    // A shortest cycle through component[0] that stays inside the
+    // component, following dependents; the first vertex is repeated last.
+    std::vector<std::uint32_t> shortestCycle(
+        std::span<const std::uint32_t> component) const;
+
+   private:
+    DependencyGraph() = default;
+
+    std::vector<int> ids;
+    std::vector<std::uint32_t> forwardOffsets;
+    std::vector<std::uint32_t> forwardTargets;
+    std::vector<std::uint32_t> reverseOffsets;
+    std::vector<std::uint32_t> reverseTargets;
+};
+
+template <class Compare>
+std::optional<std::vector<std::uint32_t>> DependencyGraph::topologicalOrder(
+    Compare before) const {
+    // std::priority_queue pops its largest element, so invert the order
+    auto after = [&before](std::uint32_t a, std::uint32_t b) {
+        return before(b, a);
+    };
+    std::priority_queue<std::uint32_t, std::vector<std::uint32_t>,
+                        decltype(after)>
+        ready(after);
+
+    std::vector<std::uint32_t> inDegree(getVertexCount());
+    for (std::uint32_t v = 0; v < inDegree.size(); v++) {
+        inDegree[v] = reverseOffsets[v + 1] - reverseOffsets[v];
+        if (inDegree[v] == 0) {
+            ready.push(v);
+        }
+    }
+
+    std::vector<std::uint32_t> order;
+    order.reserve(getVertexCount());
+    while (!ready.empty()) {
+        std::uint32_t v = ready.top();
+        ready.pop();
+        order.push_back(v);
+        for (std::uint32_t next : dependents(v)) {
+            if (--inDegree[next] == 0) {
+                ready.push(next);
+            }
+        }
+    }
+
+    if (order.size() != getVertexCount()) {
+        return std::nullopt;
+    }
+    return order;
+}
+
+}  // namespace core
@@ -14,6 +14,8 @@ class Queue {
     bool isEmpty();
     int getSize();
 
+    static bool isHigherPriority(const Task& a, const Task& b);
+
    private:
     std::vector<Task> heap;
 
@@ -21,8 +23,6 @@ class Queue {
     static int leftChild(int i);
     static int rightChild(int i);
 
-    bool isHigherPriority(const Task& a, const Task& b);
-
     void heapifyUp(int index);
     void heapifyDown(int index);
 };
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace core {
+// Work-stealing thread pool. Each worker pops its own deque LIFO (newest,
+// cache-hot forks first) and steals FIFO from the others when idle.
+class ThreadPool {
+   public:
+    explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> job);
+    // Runs one queued job on the calling thread; false if none was found.
+    bool runPendingJob();
+    unsigned getSize() const;
+
+    // Process-wide pool sized to the hardware, created on first use.
+    static ThreadPool& shared();
+
+   private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> jobs;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::jthread> workers;
+    std::atomic<int> pending{0};
+    std::atomic<unsigned> nextQueue{0};
+    std::mutex sleepMutex;
+    std::condition_variable wakeup;
+    bool stopping = false;
+
+    void workerLoop(unsigned index);
+    std::optional<std::function<void()>> takeJob(unsigned preferred);
+};
+
+// Fork-join scope over a ThreadPool. wait() runs queued jobs while it blocks,
+// so groups may nest inside pool jobs without starving the workers.
+class TaskGroup {
+   public:
+    explicit TaskGroup(ThreadPool& pool);
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(std::function<void()> job);
+    void wait();
+
+   private:
+    ThreadPool& pool;
+    std::atomic<int> outstanding{0};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
+
+// Splits [0, count) into chunks of at least `grain` items and runs
+// body(begin, end) for each chunk across the pool.
+void parallelFor(ThreadPool& pool, std::size_t count, std::size_t grain,
+                 const std::function<void(std::size_t, std::size_t)>& body);
+
+}  // namespace core
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "models.h"
+
+namespace core {
+
+// Natural title order: ASCII case is folded and digit runs compare by
+// numeric value, so "task 2" sorts before "Task 10". Both functions below
+// follow the same byte encoding and always agree.
+int naturalCompare(std::string_view a, std::string_view b);
+void appendNaturalKey(std::string_view title, std::string& key);
+
+// Natural keys for every row, computed once into a single arena. Each row
+// also gets its first eight key bytes as a big-endian integer, so most
+// comparisons are one integer compare and only ties read the full keys.
+class TitleKeys {
+   public:
+    explicit TitleKeys(std::span<const Task> tasks);
+
+    int compare(std::uint32_t a, std::uint32_t b) const {
+        if (prefixes[a] != prefixes[b]) {
+            return prefixes[a] < prefixes[b] ? -1 : 1;
+        }
+        return key(a).compare(key(b));
+    }
+
+   private:
+    std::string arena;
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint64_t> prefixes;
+
+    std::string_view key(std::uint32_t row) const {
+        return std::string_view(arena).substr(
+            offsets[row], offsets[row + 1] - offsets[row]);
+    }
+};
+
+}  // namespace core
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 struct UserArgs {
     int id;
@@ -18,12 +19,29 @@ struct TaskArgs {
     int filterStatus = -1;    // -1 = no filter
     int filterPriority = -1;  // -1 = no filter
     int updatePriority = -1;  // -1 = not set
+    int memoryBudgetMb = 0;   // 0 = sort in memory
+    int estimate = 1;         // hours
+    int updateEstimate = -1;  // -1 = not set
     std::string updateStatus;
     std::string updateDueDate;
     std::string updateTitle;
 };
 
+struct DepsArgs {
+    int taskId = 0;
+    int dependsOn = 0;
+    bool showAll = false;
+    bool apply = false;
+    int depth = 1;
+    int workers = 1;
+    std::string direction = "both";  // up | down | both
+    std::string format = "dot";      // dot | graphml | jsonl
+    std::string output;
+    std::vector<int> roots;
+};
+
 struct CommandArgs {
     UserArgs user;
     TaskArgs task;
+    DepsArgs deps;
 };
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "DependencyGraph.h"
+#include "ThreadPool.h"
+
+namespace core {
+// Weakly connected components, found with union-find and packed into at
+// most `maxParts` parts of similar size, largest components first. Each
+// part is a sorted list of vertices made of whole components.
+std::vector<std::vector<std::uint32_t>> partitionComponents(
+    const DependencyGraph& graph, std::size_t maxParts);
+
+// Runs analyse(subgraph, vertices) for each part on the pool and returns
+// the results in part order. Subgraph vertex i is the graph's vertices[i].
+// Unless the split can pay for itself (see the thresholds below), the whole
+// graph is analysed in place on the calling thread as a single part.
+template <class Analyse>
+auto analyseComponents(ThreadPool& pool, const DependencyGraph& graph,
+                       Analyse analyse)
+    -> std::vector<std::invoke_result_t<Analyse&, const DependencyGraph&,
+                                        std::span<const std::uint32_t>>>;
+
+// Parts per pool thread, so uneven components still balance
+constexpr std::size_t PARTS_PER_THREAD = 4;
+
+// bench_components puts the union-find and subgraph copies at about half of
+// an in-place CPM pass. The split is therefore taken only when the work can
+// run at least MIN_SPLIT_WAYS ways in parallel: that many pool threads, and
+// no part heavier than that fraction of the graph. Below MIN_SPLIT_WORK
+// vertices plus edges, the whole pass takes about a millisecond and is not
+// worth waking the pool for.
+constexpr std::size_t MIN_SPLIT_WAYS = 4;
+constexpr std::size_t MIN_SPLIT_WORK = 1 << 16;
+
+// Whether to partition at all, from the pool and graph sizes alone.
+bool shouldPartition(const ThreadPool& pool, const DependencyGraph& graph);
+// Whether a partition is balanced enough to analyse part by part.
+bool shouldSplit(const DependencyGraph& graph,
+                 const std::vector<std::vector<std::uint32_t>>& parts);
+// Skips the thresholds, splitting whenever the pool has two threads and the
+// graph two components, so benchmarks can time the split on any input.
+// Not thread-safe.
+void setComponentSplitForced(bool forced);
+
+template <class Analyse>
+auto analyseComponents(ThreadPool& pool, const DependencyGraph& graph,
+                       Analyse analyse)
+    -> std::vector<std::invoke_result_t<Analyse&, const DependencyGraph&,
+                                        std::span<const std::uint32_t>>> {
+    using Result = std::invoke_result_t<Analyse&, const DependencyGraph&,
+                                        std::span<const std::uint32_t>>;
+    std::vector<std::vector<std::uint32_t>> parts;
+    if (shouldPartition(pool, graph)) {
+        parts = partitionComponents(
+            graph,
+            static_cast<std::size_t>(pool.getSize()) * PARTS_PER_THREAD);
+    }
+
+    std::vector<Result> results;
+    if (!shouldSplit(graph, parts)) {
+        std::vector<std::uint32_t> all(graph.getVertexCount());
+        std::iota(all.begin(), all.end(), 0);
+        results.push_back(analyse(graph, all));
+        return results;
+    }
+
+    std::vector<std::uint32_t> localIndex(graph.getVertexCount());
+    for (const auto& part : parts) {
+        for (std::size_t i = 0; i < part.size(); i++) {
+            localIndex[part[i]] = static_cast<std::uint32_t>(i);
+        }
+    }
+
+    std::vector<std::optional<Result>> partial(parts.size());
+    {
+        TaskGroup group(pool);
+        for (std::size_t i = 0; i < parts.size(); i++) {
+            group.run([&, i]() {
+                partial[i].emplace(
+                    analyse(graph.subgraph(parts[i], localIndex), parts[i]));
+            });
+        }
+        group.wait();
+    }
+
+    results.reserve(parts.size());
+    for (auto& result : partial) {
+        results.push_back(std::move(*result));
+    }
+    return results;
+}
+
+}  // namespace core
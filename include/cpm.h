@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "DependencyGraph.h"
+#include "ThreadPool.h"
+#include "models.h"
+
+namespace core {
+// Critical path method over a whole graph. earliestStart is the forward
+// pass, remaining the backward one; a vertex with zero slack lies on a
+// critical path.
+struct CpmSchedule {
+    std::vector<std::int64_t> earliestStart;
+    std::vector<std::int64_t> remaining;
+    std::int64_t length = 0;
+
+    std::int64_t latestStart(std::uint32_t vertex) const {
+        return length - remaining[vertex];
+    }
+    std::int64_t slack(std::uint32_t vertex) const {
+        return latestStart(vertex) - earliestStart[vertex];
+    }
+};
+
+// durations is indexed by vertex. Returns nullopt if the graph has a cycle.
+std::optional<CpmSchedule> computeCpm(const DependencyGraph& graph,
+                                      std::span<const std::int64_t> durations);
+// The same, computed per weakly connected component across the pool
+std::optional<CpmSchedule> computeCpm(const DependencyGraph& graph,
+                                      std::span<const std::int64_t> durations,
+                                      ThreadPool& pool);
+
+// Persisted nodes with their neighbours, one indexed query per call
+struct CpmStore {
+    std::function<std::optional<CpmNode>(int taskId)> node;
+    std::function<std::vector<CpmNode>(int taskId)> prerequisites;
+    std::function<std::vector<CpmNode>(int taskId)> dependents;
+};
+
+// Incremental CPM after an edit. Earliest starts are recomputed downstream
+// of startSeeds in rank order, and remaining work upstream of
+// remainingSeeds in reverse rank order. A node whose value does not change
+// stops the walk, so only the affected part of each cone is visited.
+// Returns every node with a new value.
+std::vector<CpmNode> propagateCpm(const CpmStore& store,
+                                  std::span<const int> startSeeds,
+                                  std::span<const int> remainingSeeds);
+
+}  // namespace core
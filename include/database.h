@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "SQLiteCpp/Database.h"
@@ -24,14 +27,88 @@ bool updateUsername(const std::string &oldUsername,
 // TODO: Delete Database
 
 bool createTask(const std::string &title, int priority, int status,
-                std::time_t dueDate);
+                std::time_t dueDate, int estimate = 1);
 std::optional<Task> getTask(int id);
 std::vector<Task> getTasksByUser();
 std::vector<Task> getIncompleteTasksByUser();
+// Incomplete tasks whose prerequisites are all complete or cancelled
+std::vector<Task> getReadyTasks();
+// Streams rows one at a time without collecting them
+bool forEachTask(bool includeComplete,
+                 const std::function<void(Task &&)> &visit);
 bool updateTaskStatus(int id, int status);
 bool updateTaskPriority(int id, int priority);
 bool updateTaskDueDate(int id, std::time_t dueDate);
 bool updateTaskTitle(int id, const std::string &title);
+bool updateTaskEstimate(int id, int estimate);
 bool deleteTask(int id);
 
+// Inserts the edge and applies its topological rank changes atomically
+bool addDependency(int taskId, int dependsOn,
+                   const std::vector<TopoRank> &ranks);
+bool removeDependency(int taskId, int dependsOn);
+// Deletes edges implied by longer chains in one transaction. Reachability
+// and critical path times are unchanged by that, so their indexes stay valid.
+bool removeRedundantDependencies(const std::vector<Dependency> &edges);
+bool hasDependency(int taskId, int dependsOn);
+std::vector<Dependency> getDependencies();
+// Streams every task, then every edge, row by row. With roots, only the
+// roots, the tasks reachable from them upstream and/or downstream, and the
+// edges among those.
+bool forEachInGraph(const std::vector<int> &roots, bool upstream,
+                    bool downstream,
+                    const std::function<void(Task &&)> &visitTask,
+                    const std::function<void(Dependency)> &visitDependency);
+// Tasks within maxDepth edges of taskId, following prerequisites (Upstream)
+// or dependents (Downstream), ordered by depth then id
+std::vector<TaskAtDepth> getNeighbourhood(int taskId, ReachDirection direction,
+                                          int maxDepth);
+
+// False until ranks exist for every task with an edge
+bool isTopoRanked();
+// Replaces all ranks, e.g. on first use with edges from an older database
+bool saveTopoRanks(const std::vector<TopoRank> &ranks);
+std::optional<std::int64_t> getTopoRank(int taskId);
+// Lowest and highest rank in use, or nullopt when no task is ranked
+std::optional<std::pair<std::int64_t, std::int64_t>> getTopoRankRange();
+// Indexed neighbour lookups bounded by rank, for the Pearce-Kelly search
+std::vector<TopoRank> getDependentsRankedUpTo(int taskId, std::int64_t bound);
+std::vector<TopoRank> getPrerequisitesRankedFrom(int taskId,
+                                                 std::int64_t bound);
+
+// Persisted critical path times, kept for every ranked task. Edits mark them
+// stale through triggers until saveCpmTimes runs.
+bool isCpmValid();
+bool saveCpmTimes(const std::vector<CpmNode> &nodes, bool replaceAll);
+std::vector<CpmNode> getCpmNodes();
+// getCpmNodes joined with the task rows, in one query
+std::vector<TaskCpm> getCpmTasks();
+std::optional<CpmNode> getCpmNode(int taskId);
+std::vector<CpmNode> getCpmPrerequisites(int taskId);
+std::vector<CpmNode> getCpmDependents(int taskId);
+
+// Reachability index over task slots. Edge edits mark it stale through
+// triggers until the next save.
+bool isReachValid();
+bool rebuildReachIndex(
+    const std::vector<std::pair<int, std::uint32_t>> &slots,
+    const std::vector<ReachSet> &sets);
+bool saveReachSets(const std::vector<ReachSet> &sets);
+std::optional<std::uint32_t> getReachSlot(int taskId);
+// Existing slot, or the next free one for a task gaining its first edge
+std::optional<std::uint32_t> assignReachSlot(int taskId);
+std::vector<ReachChunk> getReachChunks(std::uint32_t slot,
+                                       ReachDirection direction);
+std::vector<RankedSlot> getReachNeighbours(std::uint32_t slot,
+                                           ReachDirection direction);
+std::optional<std::int64_t> getReachSlotRank(std::uint32_t slot);
+// Whether toTaskId is downstream of fromTaskId: one indexed chunk lookup
+std::optional<bool> isReachable(int fromTaskId, int toTaskId);
+std::vector<Task> getTasksBySlots(const std::vector<std::uint32_t> &slots);
+
+// Cached top of the `task next` queue, valid while tasks_version is unchanged
+std::int64_t getTasksVersion();
+std::optional<std::vector<Task>> getQueueSnapshot(std::int64_t version);
+bool saveQueueSnapshot(std::int64_t version, const std::vector<Task> &tasks);
+
 }  // namespace db
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "models.h"
+#include "sortspec.h"
+
+namespace core {
+// Sorts a stream of tasks larger than memory. Tasks are buffered until the
+// memory budget is reached, sorted, and appended to one temporary file as a
+// run; finish() k-way merges the runs through a heap. Each merged run needs
+// a read buffer, so a merge takes at most as many runs as the budget has
+// buffers, and more runs than that are merged in several passes through
+// intermediate runs. Ties keep input order.
+class ExternalSorter {
+   public:
+    ExternalSorter(const SortSpec& spec, std::size_t memoryBudget);
+
+    void add(Task task);
+    // Emits every added task in sorted order. Call once.
+    void finish(const std::function<void(const Task&)>& emit);
+
+    std::size_t getRunCount() const;
+
+   private:
+    struct FileCloser {
+        void operator()(std::FILE* file) const { std::fclose(file); }
+    };
+    using RunFile = std::unique_ptr<std::FILE, FileCloser>;
+
+    // Byte range of one sorted run within a spill file
+    struct Run {
+        long begin;
+        long end;
+    };
+
+    SortSpec spec;
+    SortComparator comparator;
+    std::size_t memoryBudget;
+    std::size_t bufferedBytes = 0;
+    std::vector<Task> buffer;
+    RunFile spillFile;
+    std::vector<Run> runs;
+
+    static std::size_t footprint(const Task& task);
+    std::size_t runBufferSize() const;
+    std::size_t maxFanIn() const;
+    RunFile createRunFile() const;
+    void spill();
+    void mergeRuns(std::span<const Run> group,
+                   const std::function<void(const Task&)>& emit) const;
+};
+
+}  // namespace core
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "models.h"
+
+namespace core {
+enum class ExportFormat { Dot, GraphML, Jsonl };
+
+// "dot", "graphml" or "jsonl"
+std::optional<ExportFormat> parseExportFormat(std::string_view name);
+
+// Writes the dependency graph to a file one task or edge at a time. Output
+// goes through a fixed buffer, so memory stays constant however large the
+// graph is. Edges point from the prerequisite to the task that waits on it.
+// Throws std::runtime_error if the file cannot be opened or written.
+class GraphExporter {
+   public:
+    GraphExporter(const std::string& path, ExportFormat format);
+
+    // Every task must be written before the first edge
+    void writeTask(const Task& task);
+    void writeDependency(const Dependency& dependency);
+    // Closes the document and flushes it. Call once.
+    void finish();
+
+   private:
+    struct FileCloser {
+        void operator()(std::FILE* file) const { std::fclose(file); }
+    };
+
+    static constexpr std::size_t BUFFER_SIZE = 1 << 16;
+
+    std::unique_ptr<std::FILE, FileCloser> file;
+    ExportFormat format;
+    std::string buffer;
+
+    void appendEscaped(std::string_view text);
+    void writeBuffer();
+};
+
+}  // namespace core
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "DependencyGraph.h"
+
+namespace core {
+struct ScheduledTask {
+    std::uint32_t vertex = 0;
+    int worker = 0;
+    std::int64_t start = 0;
+    std::int64_t finish = 0;
+};
+
+struct ListSchedule {
+    // In order of start time, then worker
+    std::vector<ScheduledTask> assignments;
+    std::int64_t makespan = 0;
+    // Longest chain of work, the makespan with unlimited workers
+    std::int64_t criticalPath = 0;
+};
+
+// Event-driven list scheduling with `workerCount` workers. Whenever a
+// worker is free, it takes the ready task with the best priority (lowest
+// number), then least slack, then lowest vertex. durations and priorities
+// are indexed by vertex. Returns nullopt if the graph has a cycle.
+std::optional<ListSchedule> scheduleWork(
+    const DependencyGraph& graph, std::span<const std::int64_t> durations,
+    std::span<const int> priorities, int workerCount);
+
+}  // namespace core
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstdint>
 #include <ctime>
 #include <string>
+#include <vector>
 
 struct User {
     std::string username;
@@ -15,6 +17,67 @@ struct Task {
     int status = -1;
     std::time_t dueDate = 0;
     std::time_t creationTime = 0;
+    int estimate = 1;  // hours of work
+};
+
+// A row of task_dependencies: taskId cannot start before dependsOn is done
+struct Dependency {
+    int taskId = 0;
+    int dependsOn = 0;
+};
+
+// Position of a task in the persisted topological order of the dependency
+// graph: every prerequisite has a lower rank than the tasks waiting on it
+struct TopoRank {
+    int taskId = 0;
+    std::int64_t rank = 0;
+};
+
+// Critical path times of a ranked task, in estimate hours. duration is the
+// estimate, or 0 once the task is complete or cancelled.
+struct CpmNode {
+    int taskId = 0;
+    std::int64_t rank = 0;
+    int duration = 0;
+    std::int64_t earliestStart = 0;
+    // Longest chain of work from this task's start to the end of the plan
+    std::int64_t remaining = 0;
+};
+
+// Reachability sets are bitsets over dense per-task slots, stored in chunks
+// of REACH_CHUNK_BITS so sparse sets skip empty ranges.
+constexpr std::uint32_t REACH_CHUNK_BITS = 1024;
+
+// Bits [index * REACH_CHUNK_BITS, (index + 1) * REACH_CHUNK_BITS) of a set
+struct ReachChunk {
+    std::uint32_t index = 0;
+    std::vector<std::uint64_t> words;
+};
+
+enum class ReachDirection : int { Downstream = 0, Upstream = 1 };
+
+// Every slot reachable from `slot` by following edges in one direction
+struct ReachSet {
+    std::uint32_t slot = 0;
+    ReachDirection direction = ReachDirection::Downstream;
+    std::vector<ReachChunk> chunks;
+};
+
+struct RankedSlot {
+    std::uint32_t slot = 0;
+    std::int64_t rank = 0;
+};
+
+// A task found by a bounded walk, with its fewest edges from the start
+struct TaskAtDepth {
+    Task task;
+    int depth = 0;
+};
+
+// A ranked task with its critical path times
+struct TaskCpm {
+    Task task;
+    CpmNode node;
 };
 
 enum class TaskStatus : int {
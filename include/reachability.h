@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "DependencyGraph.h"
+#include "models.h"
+
+namespace core {
+// Persisted reachability sets and the edges between slots, one indexed
+// query per call
+struct ReachStore {
+    std::function<std::vector<ReachChunk>(std::uint32_t slot,
+                                          ReachDirection direction)>
+        load;
+    // Direct dependents (Downstream) or prerequisites (Upstream) of a slot
+    std::function<std::vector<RankedSlot>(std::uint32_t slot,
+                                          ReachDirection direction)>
+        neighbours;
+    std::function<std::optional<std::int64_t>(std::uint32_t slot)> rank;
+};
+
+// Transitive closure of the whole graph in both directions, with each
+// vertex index as its slot. Returns nullopt if the graph has a cycle.
+std::optional<std::vector<ReachSet>> buildReach(const DependencyGraph& graph);
+
+// After adding the edge from -> to: every ancestor of `from` (and `from`
+// itself) now reaches everything `to` reaches, and symmetrically upstream.
+// Only those sets are loaded and unioned.
+std::vector<ReachSet> addReachEdge(const ReachStore& store, std::uint32_t from,
+                                   std::uint32_t to);
+
+// After edges are removed, rebuilds the downstream sets of
+// `downstreamSlots` from their dependents in reverse rank order, and the
+// upstream sets of `upstreamSlots` from their prerequisites in rank order.
+std::vector<ReachSet> recomputeReach(
+    const ReachStore& store, std::span<const std::uint32_t> downstreamSlots,
+    std::span<const std::uint32_t> upstreamSlots);
+
+}  // namespace core
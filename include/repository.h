@@ -4,28 +4,46 @@
 #include <string>
 #include <vector>
 
-#include "PriorityQueue.h"
+#include "BucketQueue.h"
 #include "commands.h"
 #include "models.h"
-#include "sorting.h"
 
 
 namespace repo {
-core::Queue loadUserTaskQueue();
+core::BucketQueue loadUserTaskQueue();
 void getNextPriorityTask();
 
-std::vector<Task> getSortedTasks(bool (*comparator)(const Task &,
-                                                    const Task &));
-
 void showTask(int taskId);
 void showAllTasks();
 void listTasks(bool showAll, int filterStatus, int filterPriority,
-               const std::string &sortBy);
+               const std::string &sortBy, int memoryBudgetMb = 0);
 
 void updateTaskPriority(int taskId, int priority);
 void updateTaskStatus(int taskId, int status);
 void updateTaskDueDate(int taskId, std::time_t dueDate);
 void updateTaskTitle(int taskId, const std::string &title);
+void updateTaskEstimate(int taskId, int estimate);
 void deleteTask(int taskId);
 
+void addDependency(int taskId, int dependsOn);
+void removeDependency(int taskId, int dependsOn);
+// Tasks within `depth` edges of taskId; direction is up, down, or both
+void showDependencies(int taskId, int depth, const std::string &direction);
+// Streams the graph, or the part reachable from roots, to a file
+void exportDependencies(const std::string &format, const std::string &path,
+                        const std::vector<int> &roots,
+                        const std::string &direction);
+// Lists edges implied by longer chains, and deletes them when apply is set
+void reduceDependencies(bool apply);
+// Reports every group of tasks that wait on each other in a cycle
+void checkDependencies();
+void showExecutionPlan();
+void showCriticalPath(bool showAll);
+// Simulates `workers` people taking ready tasks by priority, then slack
+void showSchedule(int workers);
+// With otherId 0, lists every task taskId transitively waits on; otherwise
+// answers whether taskId waits on otherId
+void showBlockers(int taskId, int otherId);
+void showDownstream(int taskId);
+
 }  // namespace repo
\ No newline at end of file
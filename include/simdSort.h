@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace core {
+
+// Sorts packed 64-bit values, typically (key << 32 | row index), ascending.
+// MSD radix passes split the input until ranges are small; those leaves are
+// sorted as 16-element blocks by an AVX2 sorting network and merged with a
+// 4-wide bitonic merge kernel. CPUs without AVX2 get the scalar
+// equivalents, chosen once at runtime.
+void sortPacked(std::span<std::uint64_t> values);
+
+// Whether sortPacked is using the AVX2 kernels on this CPU.
+bool hasSimdSort();
+
+// Switches the AVX2 kernels off, or back on where the CPU supports them, so
+// benchmarks can compare them with the scalar kernels. Not thread-safe.
+void setSimdSortEnabled(bool enabled);
+
+}  // namespace core
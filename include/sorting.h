@@ -1,36 +1,409 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
 #include <vector>
 
+#include "ThreadPool.h"
 #include "models.h"
 
 namespace core {
 
-void mergeSort(std::vector<Task>& tasks,
+namespace detail {
+
+template <class T, class Compare>
+void merge(std::span<T> tasks, int left, int mid, int right,
+           Compare& comparator, std::span<T> temp) {
+    int i = left;
+    int j = mid + 1;
+    int k = left;
+
+    while (i <= mid && j <= right) {
+        if (!comparator(tasks[j], tasks[i])) {
+            temp[k++] = tasks[i++];
+        } else {
+            temp[k++] = tasks[j++];
+        }
+    }
+
+    while (i <= mid) {
+        temp[k++] = tasks[i++];
+    }
+
+    while (j <= right) {
+        temp[k++] = tasks[j++];
+    }
+
+    for (i = left; i <= right; i++) {
+        tasks[i] = temp[i];
+    }
+}
+
+template <class T, class Compare>
+void mergeSortHelper(std::span<T> tasks, int left, int right,
+                     Compare& comparator, std::span<T> temp) {
+    if (left >= right) {
+        return;
+    }
+
+    int mid = left + (right - left) / 2;
+
+    mergeSortHelper(tasks, left, mid, comparator, temp);
+    mergeSortHelper(tasks, mid + 1, right, comparator, temp);
+    merge(tasks, left, mid, right, comparator, temp);
+}
+
+// Runs shorter than this are extended with binary insertion sort
+constexpr std::size_t MIN_RUN = 32;
+// Consecutive wins by one side before a merge switches to galloping
+constexpr std::size_t MIN_GALLOP = 7;
+
+// Number of leading elements of `run` that must precede `key`: those
+// strictly less than it, or, when `keyFirst` is false, not greater than it.
+// Exponential probing keeps this O(log k) for a short prefix.
+template <class T, class Compare>
+std::size_t gallop(const T& key, std::span<T> run, bool keyFirst,
+                   Compare& comparator) {
+    auto precedes = [&](const T& item) {
+        return keyFirst ? comparator(item, key) : !comparator(key, item);
+    };
+
+    std::size_t bound = 1;
+    while (bound <= run.size() && precedes(run[bound - 1])) {
+        bound *= 2;
+    }
+    std::size_t low = bound / 2;
+    std::size_t high = std::min(bound - 1, run.size());
+    return low + (std::partition_point(run.begin() + low, run.begin() + high,
+                                       precedes) -
+                  (run.begin() + low));
+}
+
+// Stable merge of adjacent sorted runs a and b into out. After MIN_GALLOP
+// consecutive wins by one side, the rest of its winning streak is found by
+// galloping and moved in bulk.
+template <class T, class Compare>
+void gallopingMerge(std::span<T> a, std::span<T> b, std::span<T> out,
+                    Compare& comparator) {
+    std::size_t i = 0;
+    std::size_t j = 0;
+    std::size_t k = 0;
+    std::size_t winsA = 0;
+    std::size_t winsB = 0;
+
+    while (i < a.size() && j < b.size()) {
+        if (winsA >= MIN_GALLOP) {
+            std::size_t count = gallop(b[j], a.subspan(i), false, comparator);
+            k = std::move(a.begin() + i, a.begin() + i + count,
+                          out.begin() + k) -
+                out.begin();
+            i += count;
+            winsA = 0;
+            continue;
+        }
+        if (winsB >= MIN_GALLOP) {
+            std::size_t count = gallop(a[i], b.subspan(j), true, comparator);
+            k = std::move(b.begin() + j, b.begin() + j + count,
+                          out.begin() + k) -
+                out.begin();
+            j += count;
+            winsB = 0;
+            continue;
+        }
+
+        if (!comparator(b[j], a[i])) {
+            out[k++] = std::move(a[i++]);
+            winsA++;
+            winsB = 0;
+        } else {
+            out[k++] = std::move(b[j++]);
+            winsB++;
+            winsA = 0;
+        }
+    }
+
+    k = std::move(a.begin() + i, a.end(), out.begin() + k) - out.begin();
+    std::move(b.begin() + j, b.end(), out.begin() + k);
+}
+
+// Bottom-up natural merge sort: existing ascending (or strictly descending,
+// reversed in place) runs are kept, short ones padded to MIN_RUN, and pairs
+// of runs are merged back and forth between `items` and one buffer. Input
+// that is already sorted is a single run and costs one O(n) scan.
+template <class T, class Compare>
+void adaptiveMergeSort(std::span<T> items, Compare& comparator) {
+    std::size_t n = items.size();
+    if (n <= 1) {
+        return;
+    }
+
+    std::vector<std::size_t> bounds{0};
+    for (std::size_t start = 0; start < n;) {
+        std::size_t end = start + 1;
+        if (end < n && comparator(items[end], items[start])) {
+            while (end < n && comparator(items[end], items[end - 1])) {
+                end++;
+            }
+            std::reverse(items.begin() + start, items.begin() + end);
+        } else {
+            while (end < n && !comparator(items[end], items[end - 1])) {
+                end++;
+            }
+        }
+
+        std::size_t padded = std::min(n, std::max(end, start + MIN_RUN));
+        for (; end < padded; end++) {
+            T item = std::move(items[end]);
+            auto position =
+                std::upper_bound(items.begin() + start, items.begin() + end,
+                                 item, comparator);
+            std::move_backward(position, items.begin() + end,
+                               items.begin() + end + 1);
+            *position = std::move(item);
+        }
+
+        bounds.push_back(end);
+        start = end;
+    }
+
+    if (bounds.size() == 2) {
+        return;
+    }
+
+    std::vector<T> buffer(n);
+    std::span<T> source = items;
+    std::span<T> target = buffer;
+
+    while (bounds.size() > 2) {
+        std::vector<std::size_t> merged{0};
+        std::size_t run = 0;
+        for (; run + 2 < bounds.size(); run += 2) {
+            std::size_t low = bounds[run];
+            std::size_t mid = bounds[run + 1];
+            std::size_t high = bounds[run + 2];
+
+            // Runs already in order only need moving across
+            if (!comparator(source[mid], source[mid - 1])) {
+                std::move(source.begin() + low, source.begin() + high,
+                          target.begin() + low);
+            } else {
+                gallopingMerge(source.subspan(low, mid - low),
+                               source.subspan(mid, high - mid),
+                               target.subspan(low, high - low), comparator);
+            }
+            merged.push_back(high);
+        }
+        if (run + 1 < bounds.size()) {
+            std::move(source.begin() + bounds[run], source.end(),
+                      target.begin() + bounds[run]);
+            merged.push_back(n);
+        }
+
+        bounds.swap(merged);
+        std::swap(source, target);
+    }
+
+    if (source.data() != items.data()) {
+        std::move(source.begin(), source.end(), items.begin());
+    }
+}
+
+// Each worker sorts or merges at least this many items at a time
+constexpr std::size_t PARALLEL_GRAIN = 16384;
+
+// One merge of adjacent runs a and b into out, or a slice of one
+template <class T>
+struct MergeJob {
+    std::span<T> a;
+    std::span<T> b;
+    std::span<T> out;
+};
+
+// Cuts the merge of a and b into `pieces` independent merges. Each cut
+// splits the longer run at an even step and finds the matching position in
+// the other run by binary search, placing ties from a first to stay stable.
+template <class T, class Compare>
+void splitMerge(std::span<T> a, std::span<T> b, std::span<T> out,
+                std::size_t pieces, Compare& comparator,
+                std::vector<MergeJob<T>>& jobs) {
+    std::size_t i = 0;
+    std::size_t j = 0;
+    for (std::size_t piece = 1; piece <= pieces; piece++) {
+        std::size_t nextI = a.size();
+        std::size_t nextJ = b.size();
+        if (piece < pieces) {
+            if (a.size() >= b.size()) {
+                nextI = std::max(i, a.size() * piece / pieces);
+                nextJ = std::lower_bound(b.begin() + j, b.end(), a[nextI],
+                                         comparator) -
+                        b.begin();
+            } else {
+                nextJ = std::max(j, b.size() * piece / pieces);
+                nextI = std::upper_bound(a.begin() + i, a.end(), b[nextJ],
+                                         comparator) -
+                        a.begin();
+            }
+        }
+        if (nextI > i || nextJ > j) {
+            jobs.push_back({a.subspan(i, nextI - i), b.subspan(j, nextJ - j),
+                            out.subspan(i + j, nextI - i + nextJ - j)});
+        }
+        i = nextI;
+        j = nextJ;
+    }
+}
+
+// adaptiveMergeSort over the pool: equal chunks are sorted by separate
+// workers, then merged pairwise level by level. Once a level has fewer
+// merges than workers, each merge is cut into slices so every worker still
+// has one. Falls back to the sequential sort below two chunks of work.
+template <class T, class Compare>
+void parallelAdaptiveMergeSort(std::span<T> items, Compare& comparator,
+                               ThreadPool& pool) {
+    std::size_t n = items.size();
+    std::size_t threads = pool.getSize();
+    std::size_t chunks = std::min(threads, n / PARALLEL_GRAIN);
+    if (chunks < 2) {
+        adaptiveMergeSort(items, comparator);
+        return;
+    }
+
+    std::vector<std::size_t> bounds(chunks + 1);
+    for (std::size_t c = 0; c <= chunks; c++) {
+        bounds[c] = n * c / chunks;
+    }
+    parallelFor(pool, chunks, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t c = begin; c < end; c++) {
+            adaptiveMergeSort(
+                items.subspan(bounds[c], bounds[c + 1] - bounds[c]),
+                comparator);
+        }
+    });
+
+    std::vector<T> buffer(n);
+    std::span<T> source = items;
+    std::span<T> target = buffer;
+
+    while (bounds.size() > 2) {
+        std::vector<MergeJob<T>> jobs;
+        std::vector<std::size_t> merged{0};
+        std::size_t merges = (bounds.size() - 1) / 2;
+        std::size_t run = 0;
+        for (; run + 2 < bounds.size(); run += 2) {
+            std::size_t low = bounds[run];
+            std::size_t mid = bounds[run + 1];
+            std::size_t high = bounds[run + 2];
+            std::size_t pieces = std::clamp<std::size_t>(
+                threads / merges, 1, (high - low) / PARALLEL_GRAIN + 1);
+            splitMerge(source.subspan(low, mid - low),
+                       source.subspan(mid, high - mid),
+                       target.subspan(low, high - low), pieces, comparator,
+                       jobs);
+            merged.push_back(high);
+        }
+        if (run + 1 < bounds.size()) {
+            jobs.push_back({source.subspan(bounds[run]), std::span<T>(),
+                            target.subspan(bounds[run])});
+            merged.push_back(n);
+        }
+
+        parallelFor(pool, jobs.size(), 1,
+                    [&](std::size_t begin, std::size_t end) {
+                        for (std::size_t k = begin; k < end; k++) {
+                            gallopingMerge(jobs[k].a, jobs[k].b, jobs[k].out,
+                                           comparator);
+                        }
+                    });
+
+        bounds.swap(merged);
+        std::swap(source, target);
+    }
+
+    if (source.data() != items.data()) {
+        std::move(source.begin(), source.end(), items.begin());
+    }
+}
+
+}  // namespace detail
+
+// Comparators are passed by type so merge() can inline every comparison.
+template <class Compare>
+void mergeSort(std::span<Task> tasks, Compare comparator) {
+    if (tasks.size() <= 1) {
+        return;
+    }
+
+    std::vector<Task> temp(tasks.size());
+    detail::mergeSortHelper(tasks, 0, static_cast<int>(tasks.size()) - 1,
+                            comparator, std::span<Task>(temp));
+}
+
+// Stable and adaptive: natural runs in the input (rows arrive from SQLite
+// in rowid order) are detected and merged, so presorted input is O(n).
+template <class Compare>
+void adaptiveMergeSort(std::span<Task> tasks, Compare comparator) {
+    detail::adaptiveMergeSort(tasks, comparator);
+}
+
+// Sorts 32-bit row indices rather than the rows, so a merge pass moves four
+// bytes per task instead of a whole Task with its title. Callers render
+// through the result.
+template <class Compare>
+std::vector<std::uint32_t> sortedOrder(std::span<const Task> tasks,
+                                       Compare comparator) {
+    std::vector<std::uint32_t> order(tasks.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (order.size() <= 1) {
+        return order;
+    }
+
+    auto byRow = [&tasks, &comparator](std::uint32_t a, std::uint32_t b) {
+        return comparator(tasks[a], tasks[b]);
+    };
+    detail::adaptiveMergeSort(std::span<std::uint32_t>(order), byRow);
+    return order;
+}
+
+// Stable LSD radix sort over n rows whose keys are given as columns, most
+// significant first. Returns the sorted order as indices into the rows.
+std::vector<std::uint32_t> radixSortPermutation(
+    std::span<const std::vector<std::uint64_t>> columns, std::size_t n);
+
+// Runtime-selected comparators; each call goes through the pointer.
+void mergeSort(std::span<Task> tasks,
                bool (*comparator)(const Task&, const Task&));
 
-inline bool byPriority(const Task& a, const Task& b) {
+// Stateless and captureless, so they inline into mergeSort and still convert
+// to plain function pointers where one is expected.
+inline constexpr auto byPriority = [](const Task& a, const Task& b) {
     return a.priority < b.priority;
-}
+};
 
-inline bool byDueDate(const Task& a, const Task& b) {
+inline constexpr auto byDueDate = [](const Task& a, const Task& b) {
     return a.dueDate < b.dueDate;
-}
+};
 
-inline bool byPriorityThenDueDate(const Task& a, const Task& b) {
+inline constexpr auto byPriorityThenDueDate = [](const Task& a,
+                                                 const Task& b) {
     if (a.priority != b.priority) {
         return a.priority < b.priority;
     }
     return a.dueDate < b.dueDate;
-}
+};
 
-inline bool byDueDateThenPriority(const Task& a, const Task& b) {
+inline constexpr auto byDueDateThenPriority = [](const Task& a,
+                                                 const Task& b) {
     if (a.dueDate != b.dueDate) {
         return a.dueDate < b.dueDate;
     }
     return a.priority < b.priority;
-}
+};
 
-inline bool byId(const Task& a, const Task& b) { return a.id < b.id; }
+inline constexpr auto byId = [](const Task& a, const Task& b) {
+    return a.id < b.id;
+};
 
-}  // namespace core
\ No newline at end of file
+}  // namespace core
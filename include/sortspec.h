@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "ThreadPool.h"
+#include "models.h"
+
+namespace core {
+
+enum class SortField { Priority, DueDate, Id, Status, Title };
+
+struct SortKey {
+    SortField field;
+    bool descending = false;
+};
+
+// An ordering such as `priority,-due,title`: keys are compared in turn and
+// a leading '-' reverses one key.
+struct SortSpec {
+    std::vector<SortKey> keys;
+};
+
+// An empty string is an empty spec, which keeps rows in database order.
+// Returns nullopt on an unknown or empty field name, so "priority," and
+// "priority,,due" are rejected.
+std::optional<SortSpec> parseSortSpec(std::string_view text);
+
+// True when every key is an integer column, so the radix engine applies.
+bool hasIntegerKeys(const SortSpec& spec);
+
+// The spec resolved once into a chain of per-field comparisons, so sorting
+// never looks at field names again. Titles compare in natural order.
+class SortComparator {
+   public:
+    explicit SortComparator(const SortSpec& spec);
+
+    bool operator()(const Task& a, const Task& b) const {
+        for (const auto& step : steps) {
+            int order = step.compare(a, b);
+            if (order != 0) {
+                return step.descending ? order > 0 : order < 0;
+            }
+        }
+        return false;
+    }
+
+   private:
+    struct Step {
+        int (*compare)(const Task&, const Task&);
+        bool descending;
+    };
+
+    std::vector<Step> steps;
+};
+
+// Stable sorted row order. Integer-only specs use the radix engine, others
+// the adaptive merge sort over precomputed natural title keys, split across
+// the pool once there are enough rows.
+std::vector<std::uint32_t> sortedOrder(std::span<const Task> tasks,
+                                       const SortSpec& spec, ThreadPool& pool);
+// As above on ThreadPool::shared(), which is only started for large inputs.
+std::vector<std::uint32_t> sortedOrder(std::span<const Task> tasks,
+                                       const SortSpec& spec);
+
+}  // namespace core
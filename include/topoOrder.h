@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "models.h"
+
+namespace core {
+// Neighbour lookups for the region search. Each call is one indexed query,
+// and only neighbours inside the rank bound are returned.
+struct RankedNeighbours {
+    // Dependents of taskId ranked at or below bound
+    std::function<std::vector<TopoRank>(int taskId, std::int64_t bound)>
+        dependentsUpTo;
+    // Prerequisites of taskId ranked at or above bound
+    std::function<std::vector<TopoRank>(int taskId, std::int64_t bound)>
+        prerequisitesFrom;
+};
+
+// Pearce-Kelly dynamic topological order: adds the edge from -> to, where
+// `from` must finish first. If the ranks already agree nothing moves.
+// Otherwise only tasks ranked between the two endpoints are searched, and
+// those found are reshuffled among their own ranks. Returns the ranks to
+// change, or nullopt if the edge would close a cycle.
+std::optional<std::vector<TopoRank>> reorderForEdge(
+    TopoRank from, TopoRank to, const RankedNeighbours& graph);
+
+}  // namespace core
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "DependencyGraph.h"
+#include "models.h"
+
+namespace core {
+// Edges implied by a longer chain, e.g. a -> c when a -> b -> c exists.
+// Removing them all leaves the transitive reduction, which has the same
+// reachability. Returns nullopt if the graph has a cycle.
+std::optional<std::vector<Dependency>> redundantEdges(
+    const DependencyGraph& graph);
+
+}  // namespace core
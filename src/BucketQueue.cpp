@@ -0,0 +1,89 @@
+#include "BucketQueue.h"
+
+#include <algorithm>
+#include <bit>
+#include <optional>
+#include <vector>
+
+#include "PriorityQueue.h"
+#include "models.h"
+
+namespace {
+// std heap algorithms build max-heaps, so invert the queue ordering
+bool isLowerPriority(const Task& a, const Task& b) {
+    return core::Queue::isHigherPriority(b, a);
+}
+}  // namespace
+
+void core::BucketQueue::insert(Task task) {
+    int index = bucketIndex(task.priority);
+    buckets[index].heap.emplace_back(std::move(task));
+    occupied |= 1u << index;
+    size++;
+}
+
+std::optional<Task> core::BucketQueue::extractMin() {
+    Bucket* bucket = firstBucket();
+    if (bucket == nullptr) {
+        return std::nullopt;
+    }
+
+    std::pop_heap(bucket->heap.begin(), bucket->heap.end(), isLowerPriority);
+    Task minTask = std::move(bucket->heap.back());
+    bucket->heap.pop_back();
+    bucket->settled--;
+    size--;
+
+    if (bucket->heap.empty()) {
+        occupied &= ~(1u << (bucket - buckets.data()));
+    }
+
+    return minTask;
+}
+
+std::optional<Task> core::BucketQueue::peek() {
+    Bucket* bucket = firstBucket();
+    if (bucket == nullptr) {
+        return std::nullopt;
+    }
+    return bucket->heap.front();
+}
+
+bool core::BucketQueue::isEmpty() { return size == 0; }
+
+int core::BucketQueue::getSize() { return size; }
+
+int core::BucketQueue::bucketIndex(int priority) {
+    // Out-of-range priorities share the nearest bucket; ordering inside a
+    // bucket still compares priority first, so results match core::Queue.
+    return std::clamp(priority, 1, BUCKET_COUNT) - 1;
+}
+
+core::BucketQueue::Bucket* core::BucketQueue::firstBucket() {
+    if (occupied == 0) {
+        return nullptr;
+    }
+
+    Bucket& bucket = buckets[std::countr_zero(occupied)];
+    settle(bucket);
+    return &bucket;
+}
+
+void core::BucketQueue::settle(Bucket& bucket) {
+    std::size_t pending = bucket.heap.size() - bucket.settled;
+    if (pending == 0) {
+        return;
+    }
+
+    // A bulk load is cheaper to heapify in one O(n) pass than to sift up
+    // element by element; a trickle of inserts is cheaper to sift.
+    if (pending > bucket.settled / 4) {
+        std::make_heap(bucket.heap.begin(), bucket.heap.end(), isLowerPriority);
+    } else {
+        for (std::size_t i = bucket.settled + 1; i <= bucket.heap.size(); i++) {
+            std::push_heap(bucket.heap.begin(), bucket.heap.begin() + i,
+                           isLowerPriority);
+        }
+    }
+    bucket.settled = bucket.heap.size();
+}
@@ -0,0 +1,61 @@
+#include "ChunkedBitset.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+#include "models.h"
+
+core::ChunkedBitset::ChunkedBitset(const std::vector<ReachChunk>& stored) {
+    for (const auto& chunk : stored) {
+        Chunk& words = chunks[chunk.index];
+        std::copy_n(chunk.words.begin(),
+                    std::min(chunk.words.size(), CHUNK_WORDS), words.begin());
+    }
+}
+
+std::vector<ReachChunk> core::ChunkedBitset::toChunks() const {
+    std::vector<ReachChunk> stored;
+    stored.reserve(chunks.size());
+    for (const auto& [index, words] : chunks) {
+        stored.push_back({index, {words.begin(), words.end()}});
+    }
+    return stored;
+}
+
+void core::ChunkedBitset::set(std::uint32_t bit) {
+    chunks[bit / REACH_CHUNK_BITS][bit % REACH_CHUNK_BITS / 64] |=
+        std::uint64_t{1} << (bit % 64);
+}
+
+bool core::ChunkedBitset::test(std::uint32_t bit) const {
+    auto it = chunks.find(bit / REACH_CHUNK_BITS);
+    if (it == chunks.end()) {
+        return false;
+    }
+    return (it->second[bit % REACH_CHUNK_BITS / 64] >> (bit % 64)) & 1;
+}
+
+bool core::ChunkedBitset::unionWith(const ChunkedBitset& other) {
+    bool changed = false;
+    for (const auto& [index, theirs] : other.chunks) {
+        Chunk& ours = chunks[index];
+        for (std::size_t w = 0; w < CHUNK_WORDS; w++) {
+            std::uint64_t merged = ours[w] | theirs[w];
+            changed = changed || merged != ours[w];
+            ours[w] = merged;
+        }
+    }
+    return changed;
+}
+
+std::size_t core::ChunkedBitset::count() const {
+    std::size_t total = 0;
+    for (const auto& [index, words] : chunks) {
+        for (std::uint64_t word : words) {
+            total += std::popcount(word);
+        }
+    }
+    return total;
+}
@@ -0,0 +1,318 @@
+#include "DependencyGraph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "ThreadPool.h"
+#include "models.h"
+
+namespace {
+// Frontier vertices per parallel chunk when releasing the next wave
+constexpr std::size_t WAVE_GRAIN = 1024;
+
+// Counting sort of edge endpoints into CSR offsets and targets
+void buildAdjacency(std::size_t vertexCount,
+                    std::span<const std::pair<std::uint32_t, std::uint32_t>>
+                        edges,
+                    std::vector<std::uint32_t>& offsets,
+                    std::vector<std::uint32_t>& targets) {
+    offsets.assign(vertexCount + 1, 0);
+    for (const auto& [from, to] : edges) {
+        offsets[from + 1]++;
+    }
+    for (std::size_t v = 0; v < vertexCount; v++) {
+        offsets[v + 1] += offsets[v];
+    }
+
+    targets.resize(edges.size());
+    std::vector<std::uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (const auto& [from, to] : edges) {
+        targets[cursor[from]++] = to;
+    }
+}
+}  // namespace
+
+core::DependencyGraph::DependencyGraph(std::vector<int> taskIds,
+                                       std::span<const Dependency> edges)
+    : ids(std::move(taskIds)) {
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+    // An edge runs from the prerequisite to the task that waits on it
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> forward;
+    forward.reserve(edges.size());
+    for (const auto& edge : edges) {
+        auto from = indexOf(edge.dependsOn);
+        auto to = indexOf(edge.taskId);
+        if (from.has_value() && to.has_value()) {
+            forward.emplace_back(*from, *to);
+        }
+    }
+    buildAdjacency(ids.size(), forward, forwardOffsets, forwardTargets);
+
+    for (auto& [from, to] : forward) {
+        std::swap(from, to);
+    }
+    buildAdjacency(ids.size(), forward, reverseOffsets, reverseTargets);
+}
+
+core::DependencyGraph core::DependencyGraph::fromEdges(
+    std::span<const Dependency> edges) {
+    std::vector<int> taskIds;
+    taskIds.reserve(edges.size() * 2);
+    for (const auto& edge : edges) {
+        taskIds.push_back(edge.taskId);
+        taskIds.push_back(edge.dependsOn);
+    }
+    return DependencyGraph(std::move(taskIds), edges);
+}
+
+core::DependencyGraph core::DependencyGraph::subgraph(
+    std::span<const std::uint32_t> vertices,
+    std::span<const std::uint32_t> localIndex) const {
+    DependencyGraph part;
+    part.ids.reserve(vertices.size());
+    part.forwardOffsets.reserve(vertices.size() + 1);
+    part.reverseOffsets.reserve(vertices.size() + 1);
+    part.forwardOffsets.push_back(0);
+    part.reverseOffsets.push_back(0);
+
+    for (std::uint32_t v : vertices) {
+        part.ids.push_back(ids[v]);
+        for (std::uint32_t next : dependents(v)) {
+            part.forwardTargets.push_back(localIndex[next]);
+        }
+        for (std::uint32_t previous : prerequisites(v)) {
+            part.reverseTargets.push_back(localIndex[previous]);
+        }
+        part.forwardOffsets.push_back(
+            static_cast<std::uint32_t>(part.forwardTargets.size()));
+        part.reverseOffsets.push_back(
+            static_cast<std::uint32_t>(part.reverseTargets.size()));
+    }
+    return part;
+}
+
+std::size_t core::DependencyGraph::getVertexCount() const {
+    return ids.size();
+}
+
+std::size_t core::DependencyGraph::getEdgeCount() const {
+    return forwardTargets.size();
+}
+
+std::optional<std::uint32_t> core::DependencyGraph::indexOf(
+    int taskId) const {
+    auto it = std::lower_bound(ids.begin(), ids.end(), taskId);
+    if (it == ids.end() || *it != taskId) {
+        return std::nullopt;
+    }
+    return static_cast<std::uint32_t>(it - ids.begin());
+}
+
+int core::DependencyGraph::taskIdAt(std::uint32_t vertex) const {
+    return ids[vertex];
+}
+
+std::span<const std::uint32_t> core::DependencyGraph::dependents(
+    std::uint32_t vertex) const {
+    return std::span<const std::uint32_t>(forwardTargets)
+        .subspan(forwardOffsets[vertex],
+                 forwardOffsets[vertex + 1] - forwardOffsets[vertex]);
+}
+
+std::span<const std::uint32_t> core::DependencyGraph::prerequisites(
+    std::uint32_t vertex) const {
+    return std::span<const std::uint32_t>(reverseTargets)
+        .subspan(reverseOffsets[vertex],
+                 reverseOffsets[vertex + 1] - reverseOffsets[vertex]);
+}
+
+bool core::DependencyGraph::reaches(std::uint32_t from,
+                                    std::uint32_t to) const {
+    std::vector<bool> visited(getVertexCount());
+    std::vector<std::uint32_t> stack{from};
+    visited[from] = true;
+
+    while (!stack.empty()) {
+        std::uint32_t v = stack.back();
+        stack.pop_back();
+        if (v == to) {
+            return true;
+        }
+        for (std::uint32_t next : dependents(v)) {
+            if (!visited[next]) {
+                visited[next] = true;
+                stack.push_back(next);
+            }
+        }
+    }
+    return false;
+}
+
+std::optional<std::vector<std::uint32_t>>
+core::DependencyGraph::topologicalOrder() const {
+    return topologicalOrder(std::less<std::uint32_t>{});
+}
+
+std::optional<std::vector<std::vector<std::uint32_t>>>
+core::DependencyGraph::waves(ThreadPool& pool) const {
+    std::size_t vertexCount = getVertexCount();
+    std::vector<std::atomic<std::uint32_t>> inDegree(vertexCount);
+    std::vector<std::uint32_t> frontier;
+    for (std::uint32_t v = 0; v < vertexCount; v++) {
+        std::uint32_t degree = reverseOffsets[v + 1] - reverseOffsets[v];
+        inDegree[v].store(degree, std::memory_order_relaxed);
+        if (degree == 0) {
+            frontier.push_back(v);
+        }
+    }
+
+    std::vector<std::vector<std::uint32_t>> result;
+    std::vector<std::uint32_t> released(vertexCount);
+    std::size_t emitted = 0;
+    while (!frontier.empty()) {
+        // Whichever thread takes a vertex's last prerequisite releases it,
+        // claiming a slot in the next wave with one atomic increment.
+        std::atomic<std::size_t> releasedCount{0};
+        parallelFor(pool, frontier.size(), WAVE_GRAIN,
+                    [&](std::size_t begin, std::size_t end) {
+                        for (std::size_t i = begin; i < end; i++) {
+                            for (std::uint32_t next : dependents(frontier[i])) {
+                                if (inDegree[next].fetch_sub(
+                                        1, std::memory_order_acq_rel) == 1) {
+                                    released[releasedCount.fetch_add(
+                                        1, std::memory_order_relaxed)] = next;
+                                }
+                            }
+                        }
+                    });
+
+        emitted += frontier.size();
+        result.push_back(std::move(frontier));
+        frontier.assign(released.begin(),
+                        released.begin() + releasedCount.load());
+    }
+
+    if (emitted != vertexCount) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+std::vector<std::vector<std::uint32_t>>
+core::DependencyGraph::cyclicComponents() const {
+    std::size_t vertexCount = getVertexCount();
+    // rindex is 0 for unvisited vertices, a DFS index while a vertex is
+    // open, and its component label once closed. Labels count down from
+    // the top, above every open index, so closed vertices never lower an
+    // open one's rindex.
+    std::vector<std::uint32_t> rindex(vertexCount, 0);
+    std::vector<bool> isRoot(vertexCount, false);
+    std::vector<std::uint32_t> pending;
+
+    struct Frame {
+        std::uint32_t vertex;
+        std::uint32_t nextEdge;
+    };
+    std::vector<Frame> calls;
+
+    std::uint32_t index = 1;
+    auto label = static_cast<std::uint32_t>(vertexCount);
+    std::vector<std::vector<std::uint32_t>> components;
+
+    for (std::uint32_t start = 0; start < vertexCount; start++) {
+        if (rindex[start] != 0) {
+            continue;
+        }
+        rindex[start] = index++;
+        isRoot[start] = true;
+        calls.push_back({start, 0});
+
+        while (!calls.empty()) {
+            Frame& frame = calls.back();
+            std::uint32_t v = frame.vertex;
+            auto next = dependents(v);
+
+            if (frame.nextEdge < next.size()) {
+                std::uint32_t w = next[frame.nextEdge];
+                if (rindex[w] == 0) {
+                    // Descend; this edge is looked at again on return
+                    rindex[w] = index++;
+                    isRoot[w] = true;
+                    calls.push_back({w, 0});
+                    continue;
+                }
+                if (rindex[w] < rindex[v]) {
+                    rindex[v] = rindex[w];
+                    isRoot[v] = false;
+                }
+                frame.nextEdge++;
+                continue;
+            }
+
+            calls.pop_back();
+            if (!isRoot[v]) {
+                pending.push_back(v);
+                continue;
+            }
+
+            std::vector<std::uint32_t> component{v};
+            index--;
+            while (!pending.empty() && rindex[v] <= rindex[pending.back()]) {
+                std::uint32_t w = pending.back();
+                pending.pop_back();
+                rindex[w] = label;
+                index--;
+                component.push_back(w);
+            }
+            rindex[v] = label--;
+            if (component.size() > 1) {
+                std::sort(component.begin(), component.end());
+                components.push_back(std::move(component));
+            }
+        }
+    }
+
+    std::sort(components.begin(), components.end());
+    return components;
+}
+
+std::vector<std::uint32_t> core::DependencyGraph::shortestCycle(
+    std::span<const std::uint32_t> component) const {
+    // Breadth-first from the first vertex back to itself, with parents
+    // kept only for the component's vertices
+    std::unordered_map<std::uint32_t, std::uint32_t> parent;
+    parent.reserve(component.size());
+    std::unordered_set<std::uint32_t> inside(component.begin(),
+                                             component.end());
+
+    std::uint32_t start = component.front();
+    std::vector<std::uint32_t> frontier{start};
+    for (std::size_t head = 0; head < frontier.size(); head++) {
+        std::uint32_t v = frontier[head];
+        for (std::uint32_t w : dependents(v)) {
+            if (w == start) {
+                std::vector<std::uint32_t> cycle{start};
+                for (std::uint32_t at = v; at != start; at = parent[at]) {
+                    cycle.push_back(at);
+                }
+                cycle.push_back(start);
+                std::reverse(cycle.begin() + 1, cycle.end() - 1);
+                return cycle;
+            }
+            if (inside.contains(w) && !parent.contains(w)) {
+                parent[w] = v;
+                frontier.push_back(w);
+            }
+        }
+    }
+    return {};
+}
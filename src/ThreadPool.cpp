@@ -0,0 +1,169 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace {
+thread_local core::ThreadPool* currentPool = nullptr;
+thread_local unsigned currentWorker = 0;
+}  // namespace
+
+core::ThreadPool::ThreadPool(unsigned threads) {
+    threads = std::max(1u, threads);
+    for (unsigned i = 0; i < threads; i++) {
+        queues.emplace_back(std::make_unique<WorkerQueue>());
+    }
+    for (unsigned i = 0; i < threads; i++) {
+        workers.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+core::ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(sleepMutex);
+        stopping = true;
+    }
+    wakeup.notify_all();
+    workers.clear();
+}
+
+void core::ThreadPool::submit(std::function<void()> job) {
+    unsigned index = currentPool == this
+                         ? currentWorker
+                         : nextQueue.fetch_add(1) % queues.size();
+    {
+        std::lock_guard lock(queues[index]->mutex);
+        queues[index]->jobs.emplace_back(std::move(job));
+    }
+    pending.fetch_add(1);
+
+    // Pass through the sleep mutex so a worker between checking `pending`
+    // and blocking cannot miss this notification.
+    { std::lock_guard lock(sleepMutex); }
+    wakeup.notify_one();
+}
+
+bool core::ThreadPool::runPendingJob() {
+    auto job = takeJob(currentPool == this ? currentWorker : 0);
+    if (!job.has_value()) {
+        return false;
+    }
+    (*job)();
+    return true;
+}
+
+unsigned core::ThreadPool::getSize() const { return workers.size(); }
+
+core::ThreadPool& core::ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void core::ThreadPool::workerLoop(unsigned index) {
+    currentPool = this;
+    currentWorker = index;
+
+    while (true) {
+        if (auto job = takeJob(index)) {
+            (*job)();
+            continue;
+        }
+
+        std::unique_lock lock(sleepMutex);
+        wakeup.wait(lock, [this]() { return stopping || pending.load() > 0; });
+        if (stopping && pending.load() == 0) {
+            return;
+        }
+    }
+}
+
+std::optional<std::function<void()>> core::ThreadPool::takeJob(
+    unsigned preferred) {
+    {
+        auto& own = *queues[preferred];
+        std::lock_guard lock(own.mutex);
+        if (!own.jobs.empty()) {
+            auto job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            pending.fetch_sub(1);
+            return job;
+        }
+    }
+
+    for (std::size_t offset = 1; offset < queues.size(); offset++) {
+        auto& victim = *queues[(preferred + offset) % queues.size()];
+        std::lock_guard lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            auto job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            pending.fetch_sub(1);
+            return job;
+        }
+    }
+    return std::nullopt;
+}
+
+core::TaskGroup::TaskGroup(ThreadPool& pool) : pool(pool) {}
+
+core::TaskGroup::~TaskGroup() {
+    while (outstanding.load() > 0) {
+        if (!pool.runPendingJob()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void core::TaskGroup::run(std::function<void()> job) {
+    outstanding.fetch_add(1);
+    pool.submit([this, job = std::move(job)]() {
+        try {
+            job();
+        } catch (...) {
+            std::lock_guard lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+        outstanding.fetch_sub(1);
+    });
+}
+
+void core::TaskGroup::wait() {
+    while (outstanding.load() > 0) {
+        if (!pool.runPendingJob()) {
+            std::this_thread::yield();
+        }
+    }
+
+    if (error) {
+        std::rethrow_exception(std::exchange(error, nullptr));
+    }
+}
+
+void core::parallelFor(
+    ThreadPool& pool, std::size_t count, std::size_t grain,
+    const std::function<void(std::size_t, std::size_t)>& body) {
+    grain = std::max<std::size_t>(1, grain);
+    std::size_t chunks =
+        std::min<std::size_t>((count + grain - 1) / grain,
+                              static_cast<std::size_t>(pool.getSize()) * 4);
+    if (chunks <= 1) {
+        body(0, count);
+        return;
+    }
+
+    std::size_t step = (count + chunks - 1) / chunks;
+    TaskGroup group(pool);
+    for (std::size_t begin = step; begin < count; begin += step) {
+        group.run([&body, begin, step, count]() {
+            body(begin, std::min(count, begin + step));
+        });
+    }
+    body(0, std::min(count, step));
+    group.wait();
+}
@@ -0,0 +1,135 @@
+#include "collation.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "models.h"
+
+namespace {
+// Starts an encoded digit run; below every byte a folded character can take
+constexpr int DIGIT_RUN = 0x01;
+constexpr int LOWEST_CHARACTER = 0x02;
+// A length byte with this value means "255 more digits, and another length
+// byte follows", so runs of any length encode in order
+constexpr std::size_t LENGTH_CONTINUES = 0xFF;
+
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+// Yields the natural key of a title one byte at a time. A digit run becomes
+// DIGIT_RUN, its length without leading zeros, then the significant digits,
+// so shorter numbers order first and equal lengths compare digit by digit.
+// The length is written as one LENGTH_CONTINUES byte per full 255 digits
+// and then the remainder, which keeps longer runs after shorter ones at any
+// length.
+class KeyCursor {
+   public:
+    explicit KeyCursor(std::string_view text) : text(text) {}
+
+    // Next key byte, or -1 at the end of the key
+    int next() {
+        if (state == State::Length) {
+            if (lengthLeft >= LENGTH_CONTINUES) {
+                lengthLeft -= LENGTH_CONTINUES;
+                return static_cast<int>(LENGTH_CONTINUES);
+            }
+            state = State::Digits;
+            return static_cast<int>(lengthLeft);
+        }
+        if (state == State::Digits) {
+            if (digitPos < digitsEnd) {
+                return static_cast<unsigned char>(text[digitPos++]);
+            }
+            state = State::Text;
+        }
+
+        if (pos >= text.size()) {
+            return -1;
+        }
+
+        char c = text[pos];
+        if (isDigit(c)) {
+            digitPos = pos;
+            while (pos < text.size() && isDigit(text[pos])) {
+                pos++;
+            }
+            digitsEnd = pos;
+            while (digitPos < digitsEnd && text[digitPos] == '0') {
+                digitPos++;
+            }
+            lengthLeft = digitsEnd - digitPos;
+            state = State::Length;
+            return DIGIT_RUN;
+        }
+
+        pos++;
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+        return std::max<int>(static_cast<unsigned char>(c), LOWEST_CHARACTER);
+    }
+
+   private:
+    enum class State { Text, Length, Digits };
+
+    std::string_view text;
+    std::size_t pos = 0;
+    std::size_t digitPos = 0;
+    std::size_t digitsEnd = 0;
+    std::size_t lengthLeft = 0;
+    State state = State::Text;
+};
+}  // namespace
+
+int core::naturalCompare(std::string_view a, std::string_view b) {
+    KeyCursor left(a);
+    KeyCursor right(b);
+    while (true) {
+        int x = left.next();
+        int y = right.next();
+        if (x != y) {
+            return x < y ? -1 : 1;
+        }
+        if (x < 0) {
+            return 0;
+        }
+    }
+}
+
+void core::appendNaturalKey(std::string_view title, std::string& key) {
+    KeyCursor cursor(title);
+    for (int byte = cursor.next(); byte >= 0; byte = cursor.next()) {
+        key.push_back(static_cast<char>(byte));
+    }
+}
+
+core::TitleKeys::TitleKeys(std::span<const Task> tasks) {
+    std::size_t total = 0;
+    for (const auto& task : tasks) {
+        total += task.title.size() + 2;
+    }
+    arena.reserve(total);
+    offsets.reserve(tasks.size() + 1);
+    prefixes.reserve(tasks.size());
+
+    for (const auto& task : tasks) {
+        offsets.push_back(static_cast<std::uint32_t>(arena.size()));
+        appendNaturalKey(task.title, arena);
+
+        // Zero padding never sorts above a key byte, so differing prefixes
+        // agree with the full keys; equal prefixes fall back to them
+        std::string_view key = std::string_view(arena).substr(offsets.back());
+        std::uint64_t prefix = 0;
+        for (std::size_t i = 0; i < 8; i++) {
+            prefix <<= 8;
+            if (i < key.size()) {
+                prefix |= static_cast<unsigned char>(key[i]);
+            }
+        }
+        prefixes.push_back(prefix);
+    }
+    offsets.push_back(static_cast<std::uint32_t>(arena.size()));
+}
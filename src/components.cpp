@@ -0,0 +1,145 @@
+#include "components.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "DependencyGraph.h"
+#include "ThreadPool.h"
+
+namespace {
+// Union-find with union by size and path halving
+class DisjointSets {
+   public:
+    explicit DisjointSets(std::size_t count) : parent(count), size(count, 1) {
+        std::iota(parent.begin(), parent.end(), 0);
+    }
+
+    std::uint32_t find(std::uint32_t v) {
+        while (parent[v] != v) {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    }
+
+    void unite(std::uint32_t a, std::uint32_t b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) {
+            return;
+        }
+        if (size[a] < size[b]) {
+            std::swap(a, b);
+        }
+        parent[b] = a;
+        size[a] += size[b];
+    }
+
+   private:
+    std::vector<std::uint32_t> parent;
+    std::vector<std::uint32_t> size;
+};
+
+// Set by setComponentSplitForced to bypass the split thresholds
+bool forceSplit = false;
+}  // namespace
+
+std::vector<std::vector<std::uint32_t>> core::partitionComponents(
+    const DependencyGraph& graph, std::size_t maxParts) {
+    std::size_t vertexCount = graph.getVertexCount();
+    DisjointSets sets(vertexCount);
+    for (std::uint32_t v = 0; v < vertexCount; v++) {
+        for (std::uint32_t next : graph.dependents(v)) {
+            sets.unite(v, next);
+        }
+    }
+
+    // Label components densely and total their work, counted as vertices
+    // plus edges
+    std::vector<std::uint32_t> componentOf(vertexCount);
+    std::vector<std::uint32_t> labelOfRoot(vertexCount, UINT32_MAX);
+    std::vector<std::size_t> work;
+    for (std::uint32_t v = 0; v < vertexCount; v++) {
+        std::uint32_t root = sets.find(v);
+        if (labelOfRoot[root] == UINT32_MAX) {
+            labelOfRoot[root] = static_cast<std::uint32_t>(work.size());
+            work.push_back(0);
+        }
+        componentOf[v] = labelOfRoot[root];
+        work[componentOf[v]] += 1 + graph.dependents(v).size();
+    }
+
+    std::size_t partCount =
+        std::min(std::max<std::size_t>(maxParts, 1), work.size());
+    if (partCount == 0) {
+        return {};
+    }
+
+    // Longest processing time first: each component, largest first, goes to
+    // the part with the least work so far
+    std::vector<std::uint32_t> bySize(work.size());
+    std::iota(bySize.begin(), bySize.end(), 0);
+    std::sort(bySize.begin(), bySize.end(),
+              [&work](std::uint32_t a, std::uint32_t b) {
+                  return work[a] > work[b];
+              });
+
+    using Load = std::pair<std::size_t, std::uint32_t>;  // work, part
+    std::priority_queue<Load, std::vector<Load>, std::greater<>> loads;
+    for (std::uint32_t part = 0; part < partCount; part++) {
+        loads.emplace(0, part);
+    }
+    std::vector<std::uint32_t> partOf(work.size());
+    for (std::uint32_t component : bySize) {
+        auto [load, part] = loads.top();
+        loads.pop();
+        partOf[component] = part;
+        loads.emplace(load + work[component], part);
+    }
+
+    // Ascending v keeps every part sorted
+    std::vector<std::vector<std::uint32_t>> parts(partCount);
+    for (std::uint32_t v = 0; v < vertexCount; v++) {
+        parts[partOf[componentOf[v]]].push_back(v);
+    }
+    return parts;
+}
+
+bool core::shouldPartition(const ThreadPool& pool,
+                           const DependencyGraph& graph) {
+    if (forceSplit) {
+        return pool.getSize() > 1;
+    }
+    return pool.getSize() >= MIN_SPLIT_WAYS &&
+           graph.getVertexCount() + graph.getEdgeCount() >= MIN_SPLIT_WORK;
+}
+
+bool core::shouldSplit(const DependencyGraph& graph,
+                       const std::vector<std::vector<std::uint32_t>>& parts) {
+    if (parts.size() <= 1) {
+        return false;
+    }
+    if (forceSplit) {
+        return true;
+    }
+
+    // The heaviest part bounds the parallel time, however many threads run
+    std::size_t heaviest = 0;
+    for (const auto& part : parts) {
+        std::size_t work = 0;
+        for (std::uint32_t v : part) {
+            work += 1 + graph.dependents(v).size();
+        }
+        heaviest = std::max(heaviest, work);
+    }
+    std::size_t total = graph.getVertexCount() + graph.getEdgeCount();
+    return heaviest * MIN_SPLIT_WAYS <= total;
+}
+
+void core::setComponentSplitForced(bool forced) { forceSplit = forced; }
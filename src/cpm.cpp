@@ -0,0 +1,178 @@
+#include "cpm.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "DependencyGraph.h"
+#include "ThreadPool.h"
+#include "components.h"
+#include "models.h"
+
+std::optional<core::CpmSchedule> core::computeCpm(
+    const DependencyGraph& graph, std::span<const std::int64_t> durations) {
+    auto order = graph.topologicalOrder();
+    if (!order.has_value()) {
+        return std::nullopt;
+    }
+
+    CpmSchedule schedule;
+    schedule.earliestStart.assign(graph.getVertexCount(), 0);
+    schedule.remaining.assign(graph.getVertexCount(), 0);
+
+    for (std::uint32_t v : *order) {
+        std::int64_t finish = schedule.earliestStart[v] + durations[v];
+        for (std::uint32_t next : graph.dependents(v)) {
+            schedule.earliestStart[next] =
+                std::max(schedule.earliestStart[next], finish);
+        }
+    }
+
+    for (auto it = order->rbegin(); it != order->rend(); ++it) {
+        std::int64_t after = 0;
+        for (std::uint32_t next : graph.dependents(*it)) {
+            after = std::max(after, schedule.remaining[next]);
+        }
+        schedule.remaining[*it] = durations[*it] + after;
+        schedule.length =
+            std::max(schedule.length,
+                     schedule.earliestStart[*it] + schedule.remaining[*it]);
+    }
+    return schedule;
+}
+
+std::optional<core::CpmSchedule> core::computeCpm(
+    const DependencyGraph& graph, std::span<const std::int64_t> durations,
+    ThreadPool& pool) {
+    CpmSchedule schedule;
+    schedule.earliestStart.assign(graph.getVertexCount(), 0);
+    schedule.remaining.assign(graph.getVertexCount(), 0);
+
+    // Both passes follow edges only, so components are independent and
+    // each writes its own vertices; only the project length spans them
+    auto lengths = analyseComponents(
+        pool, graph,
+        [&](const DependencyGraph& part,
+            std::span<const std::uint32_t> vertices)
+            -> std::optional<std::int64_t> {
+            std::vector<std::int64_t> partDurations;
+            partDurations.reserve(vertices.size());
+            for (std::uint32_t v : vertices) {
+                partDurations.push_back(durations[v]);
+            }
+            auto partSchedule = computeCpm(part, partDurations);
+            if (!partSchedule.has_value()) {
+                return std::nullopt;
+            }
+            for (std::size_t i = 0; i < vertices.size(); i++) {
+                schedule.earliestStart[vertices[i]] =
+                    partSchedule->earliestStart[i];
+                schedule.remaining[vertices[i]] = partSchedule->remaining[i];
+            }
+            return partSchedule->length;
+        });
+
+    for (const auto& length : lengths) {
+        if (!length.has_value()) {
+            return std::nullopt;
+        }
+        schedule.length = std::max(schedule.length, *length);
+    }
+    return schedule;
+}
+
+namespace {
+using Pending = std::pair<std::int64_t, int>;  // rank, task id
+
+// Walks one direction of the cone. `Later` orders the heap so the node
+// popped next has every input it reads already final.
+template <class Later, class Recompute, class Spread>
+void walkCone(const core::CpmStore& store, std::span<const int> seeds,
+              std::unordered_map<int, CpmNode>& updated, Recompute recompute,
+              Spread spread) {
+    auto current = [&updated](const CpmNode& node) {
+        auto it = updated.find(node.taskId);
+        return it == updated.end() ? node : it->second;
+    };
+
+    std::priority_queue<Pending, std::vector<Pending>, Later> pending;
+    std::unordered_set<int> queued;
+    for (int seed : seeds) {
+        auto node = store.node(seed);
+        if (node.has_value() && queued.insert(seed).second) {
+            pending.emplace(node->rank, seed);
+        }
+    }
+
+    while (!pending.empty()) {
+        int taskId = pending.top().second;
+        pending.pop();
+        queued.erase(taskId);
+
+        auto stored = store.node(taskId);
+        if (!stored.has_value()) {
+            continue;
+        }
+        CpmNode node = current(*stored);
+        if (!recompute(node, current)) {
+            continue;
+        }
+        updated[taskId] = node;
+
+        for (const auto& next : spread(taskId)) {
+            if (queued.insert(next.taskId).second) {
+                pending.emplace(next.rank, next.taskId);
+            }
+        }
+    }
+}
+}  // namespace
+
+std::vector<CpmNode> core::propagateCpm(const CpmStore& store,
+                                        std::span<const int> startSeeds,
+                                        std::span<const int> remainingSeeds) {
+    std::unordered_map<int, CpmNode> updated;
+
+    // Forward: lowest rank first, so every prerequisite is final
+    walkCone<std::greater<Pending>>(
+        store, startSeeds, updated,
+        [&store](CpmNode& node, const auto& current) {
+            std::int64_t start = 0;
+            for (const auto& before : store.prerequisites(node.taskId)) {
+                auto value = current(before);
+                start = std::max(start, value.earliestStart + value.duration);
+            }
+            bool changed = start != node.earliestStart;
+            node.earliestStart = start;
+            return changed;
+        },
+        store.dependents);
+
+    // Backward: highest rank first, so every dependent is final
+    walkCone<std::less<Pending>>(
+        store, remainingSeeds, updated,
+        [&store](CpmNode& node, const auto& current) {
+            std::int64_t after = 0;
+            for (const auto& next : store.dependents(node.taskId)) {
+                after = std::max(after, current(next).remaining);
+            }
+            bool changed = node.duration + after != node.remaining;
+            node.remaining = node.duration + after;
+            return changed;
+        },
+        store.prerequisites);
+
+    std::vector<CpmNode> nodes;
+    nodes.reserve(updated.size());
+    for (auto& [taskId, node] : updated) {
+        nodes.push_back(node);
+    }
+    return nodes;
+}
@@ -1,14 +1,21 @@
 #include "database.h"
 
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <exception>
+#include <format>
+#include <functional>
 #include <optional>
 #include <print>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "SQLiteCpp/Column.h"
 #include "SQLiteCpp/Database.h"
 #include "SQLiteCpp/Statement.h"
+#include "SQLiteCpp/Transaction.h"
 #include "models.h"
 
 namespace {
@@ -20,8 +27,47 @@ Task taskFromRow(SQLite::Statement &stmt) {
     task.status = stmt.getColumn(3).getInt();
     task.dueDate = stmt.getColumn(4).getInt64();
     task.creationTime = stmt.getColumn(5).getInt64();
+    task.estimate = stmt.getColumn(6).getInt();
     return task;
 }
+
+// `subgraph(id)` holds the roots and every task reachable from them in the
+// chosen directions. UNION keeps each id once, which also ends the walk.
+std::string subgraphCte(std::size_t rootCount, bool upstream,
+                        bool downstream) {
+    std::string roots;
+    for (std::size_t i = 1; i <= rootCount; i++) {
+        roots += std::format("{}(?{})", i > 1 ? ", " : "", i);
+    }
+
+    std::string cte = "WITH RECURSIVE ";
+    if (upstream) {
+        cte += std::format(
+            "up(id) AS (VALUES {} UNION "
+            "SELECT d.depends_on FROM up "
+            "JOIN task_dependencies d ON d.task_id = up.id), ",
+            roots);
+    }
+    if (downstream) {
+        cte += std::format(
+            "down(id) AS (VALUES {} UNION "
+            "SELECT d.task_id FROM down "
+            "JOIN task_dependencies d ON d.depends_on = down.id), ",
+            roots);
+    }
+    cte += upstream && downstream
+               ? "subgraph(id) AS (SELECT id FROM up UNION "
+                 "SELECT id FROM down) "
+               : std::format("subgraph(id) AS (SELECT id FROM {}) ",
+                             upstream ? "up" : "down");
+    return cte;
+}
+
+void bindRoots(SQLite::Statement &statement, const std::vector<int> &roots) {
+    for (std::size_t i = 0; i < roots.size(); i++) {
+        statement.bind(static_cast<int>(i + 1), roots[i]);
+    }
+}
 }  // namespace
 
 void db::initDatabase() {
@@ -41,9 +87,184 @@ void db::initDatabase() {
         "priority INTEGER NOT NULL DEFAULT 2, "
         "status INTEGER NOT NULL DEFAULT 0, "
         "dueDate INTEGER NOT NULL DEFAULT 0, "
-        "creationTime INTEGER NOT NULL);");
+        "creationTime INTEGER NOT NULL, "
+        "estimate INTEGER NOT NULL DEFAULT 1 CHECK (estimate >= 0), "
+        "unmet_deps INTEGER NOT NULL DEFAULT 0);");
+
+    // Databases created before estimates or readiness existed gain the
+    // columns in place
+    bool hasEstimate = false;
+    bool hasUnmetDeps = false;
+    {
+        SQLite::Statement columns(db, "PRAGMA table_info(tasks)");
+        while (columns.executeStep()) {
+            auto name = columns.getColumn(1).getString();
+            hasEstimate = hasEstimate || name == "estimate";
+            hasUnmetDeps = hasUnmetDeps || name == "unmet_deps";
+        }
+    }
+    if (!hasEstimate) {
+        db.exec(
+            "ALTER TABLE tasks ADD COLUMN "
+            "estimate INTEGER NOT NULL DEFAULT 1 CHECK (estimate >= 0);");
+    }
+    if (!hasUnmetDeps) {
+        db.exec(
+            "ALTER TABLE tasks ADD COLUMN "
+            "unmet_deps INTEGER NOT NULL DEFAULT 0;");
+    }
 
+    // Persistent change counter for the tasks table. PRAGMA data_version is
+    // per-connection and resets every run, so it cannot tag on-disk state.
+    db.exec(
+        "CREATE TABLE IF NOT EXISTS cascade_meta ("
+        "key TEXT PRIMARY KEY, "
+        "value INTEGER NOT NULL);");
+    db.exec(
+        "INSERT OR IGNORE INTO cascade_meta (key, value) VALUES "
+        "('tasks_version', 0), ('snapshot_version', -1), "
+        "('topo_ranked', 0), ('cpm_valid', 0), ('reach_valid', 0);");
+
+    for (const char *event : {"INSERT", "UPDATE", "DELETE"}) {
+        db.exec(std::format(
+            "CREATE TRIGGER IF NOT EXISTS tasks_version_{0} AFTER {0} ON tasks "
+            "BEGIN UPDATE cascade_meta SET value = value + 1 "
+            "WHERE key = 'tasks_version'; END;",
+            event));
+    }
 
+    // The primary key indexes edges by dependent task; the second index
+    // serves lookups by prerequisite.
+    db.exec(
+        "CREATE TABLE IF NOT EXISTS task_dependencies ("
+        "task_id INTEGER NOT NULL REFERENCES tasks(id) ON DELETE CASCADE, "
+        "depends_on INTEGER NOT NULL REFERENCES tasks(id) ON DELETE CASCADE, "
+        "PRIMARY KEY (task_id, depends_on), "
+        "CHECK (task_id != depends_on)) WITHOUT ROWID;");
+    db.exec(
+        "CREATE INDEX IF NOT EXISTS task_dependencies_depends_on "
+        "ON task_dependencies (depends_on, task_id);");
+
+    // unmet_deps counts a task's prerequisites that are still open. The
+    // triggers keep it current in the same transaction as each edge or
+    // status edit, so `task next` reads ready tasks straight off the
+    // partial index.
+    if (!hasUnmetDeps) {
+        db.exec(
+            "UPDATE tasks SET unmet_deps = ("
+            "SELECT COUNT(*) FROM task_dependencies d "
+            "JOIN tasks p ON p.id = d.depends_on "
+            "WHERE d.task_id = tasks.id AND p.status IN (0, 1));");
+    }
+    db.exec(
+        "CREATE INDEX IF NOT EXISTS tasks_ready ON tasks (id) "
+        "WHERE status IN (0, 1) AND unmet_deps = 0;");
+    db.exec(
+        "CREATE TRIGGER IF NOT EXISTS unmet_deps_edge_insert "
+        "AFTER INSERT ON task_dependencies BEGIN "
+        "UPDATE tasks SET unmet_deps = unmet_deps + 1 "
+        "WHERE id = NEW.task_id AND EXISTS (SELECT 1 FROM tasks "
+        "WHERE id = NEW.depends_on AND status IN (0, 1)); END;");
+    // A cascade from a deleted prerequisite finds no open task here; the
+    // task_delete trigger has already counted it
+    db.exec(
+        "CREATE TRIGGER IF NOT EXISTS unmet_deps_edge_delete "
+        "AFTER DELETE ON task_dependencies BEGIN "
+        "UPDATE tasks SET unmet_deps = unmet_deps - 1 "
+        "WHERE id = OLD.task_id AND EXISTS (SELECT 1 FROM tasks "
+        "WHERE id = OLD.depends_on AND status IN (0, 1)); END;");
+    db.exec(
+        "CREATE TRIGGER IF NOT EXISTS unmet_deps_task_delete "
+        "BEFORE DELETE ON tasks WHEN OLD.status IN (0, 1) BEGIN "
+        "UPDATE tasks SET unmet_deps = unmet_deps - 1 "
+        "WHERE id IN (SELECT task_id FROM task_dependencies "
+        "WHERE depends_on = OLD.id); END;");
+    db.exec(
+        "CREATE TRIGGER IF NOT EXISTS unmet_deps_task_status "
+        "AFTER UPDATE OF status ON tasks "
+        "WHEN (OLD.status IN (0, 1)) != (NEW.status IN (0, 1)) BEGIN "
+        "UPDATE tasks SET unmet_deps = unmet_deps + "
+        "(CASE WHEN NEW.status IN (0, 1) THEN 1 ELSE -1 END) "
+        "WHERE id IN (SELECT task_id FROM task_dependencies "
+        "WHERE depends_on = NEW.id); END;");
+
+    // Persisted topological order of the tasks that have edges. Removing an
+    // edge or a task keeps it valid, so only insertions reorder it.
+    db.exec(
+        "CREATE TABLE IF NOT EXISTS task_topo_rank ("
+        "task_id INTEGER PRIMARY KEY REFERENCES tasks(id) ON DELETE CASCADE, "
+        "rank INTEGER NOT NULL);");
+    // Serves the MIN/MAX lookups that place a task gaining its first edge and
+    // reads of the whole order by rank
+    db.exec(
+        "CREATE INDEX IF NOT EXISTS task_topo_rank_rank "
+        "ON task_topo_rank (rank);");
+
+    // Critical path times per ranked task: earliest_start is the longest
+    // chain of work before the task, remaining the longest chain from its
+    // start to the end. Missing rows read as a task with no edges.
+    db.exec(
+        "CREATE TABLE IF NOT EXISTS task_cpm ("
+        "task_id INTEGER PRIMARY KEY REFERENCES tasks(id) ON DELETE CASCADE, "
+        "earliest_start INTEGER NOT NULL, "
+        "remaining INTEGER NOT NULL);");
+    const char *duration = "CASE WHEN t.status IN (2, 3) THEN 0 "
+                           "ELSE t.estimate END";
+    db.exec(std::format(
+        "CREATE VIEW IF NOT EXISTS task_cpm_nodes AS "
+        "SELECT t.id AS task_id, r.rank AS rank, {0} AS duration, "
+        "COALESCE(c.earliest_start, 0) AS earliest_start, "
+        "COALESCE(c.remaining, {0}) AS remaining "
+        "FROM tasks t "
+        "JOIN task_topo_rank r ON r.task_id = t.id "
+        "LEFT JOIN task_cpm c ON c.task_id = t.id;",
+        duration));
+
+    // Any edit the times depend on marks them stale in its own transaction;
+    // the incremental update that follows marks them valid again
+    for (const auto &[name, event] :
+         {std::pair{"task_edit", "UPDATE OF status, estimate ON tasks"},
+          std::pair{"task_delete", "DELETE ON tasks"},
+          std::pair{"edge_insert", "INSERT ON task_dependencies"},
+          std::pair{"edge_delete", "DELETE ON task_dependencies"}}) {
+        db.exec(std::format(
+            "CREATE TRIGGER IF NOT EXISTS cpm_stale_{} AFTER {} "
+            "BEGIN UPDATE cascade_meta SET value = 0 "
+            "WHERE key = 'cpm_valid'; END;",
+            name, event));
+    }
+
+    // Reachability index: each task with an edge owns a dense slot, and
+    // task_reach holds the bitsets of slots downstream (direction 0) and
+    // upstream (direction 1) of it, one row per non-empty chunk
+    db.exec(
+        "CREATE TABLE IF NOT EXISTS task_reach_slot ("
+        "task_id INTEGER PRIMARY KEY REFERENCES tasks(id) ON DELETE CASCADE, "
+        "slot INTEGER NOT NULL UNIQUE);");
+    db.exec(
+        "CREATE TABLE IF NOT EXISTS task_reach ("
+        "slot INTEGER NOT NULL "
+        "REFERENCES task_reach_slot(slot) ON DELETE CASCADE, "
+        "direction INTEGER NOT NULL, "
+        "chunk INTEGER NOT NULL, "
+        "bits BLOB NOT NULL, "
+        "PRIMARY KEY (slot, direction, chunk)) WITHOUT ROWID;");
+
+    for (const auto &[name, event] :
+         {std::pair{"edge_insert", "INSERT ON task_dependencies"},
+          std::pair{"edge_delete", "DELETE ON task_dependencies"},
+          std::pair{"task_delete", "DELETE ON tasks"}}) {
+        db.exec(std::format(
+            "CREATE TRIGGER IF NOT EXISTS reach_stale_{} AFTER {} "
+            "BEGIN UPDATE cascade_meta SET value = 0 "
+            "WHERE key = 'reach_valid'; END;",
+            name, event));
+    }
+
+    db.exec(
+        "CREATE TABLE IF NOT EXISTS task_queue_snapshot ("
+        "rank INTEGER PRIMARY KEY, "
+        "task_id INTEGER NOT NULL);");
 }
 
 SQLite::Database &db::getConnection() {
@@ -121,19 +342,20 @@ bool db::updateUsername(const std::string &oldUsername,
 }
 
 bool db::createTask(const std::string &title, int priority, int status,
-                    std::time_t dueDate) {
+                    std::time_t dueDate, int estimate) {
     auto &db = db::getConnection();
 
     try {
         SQLite::Statement insert(db,
                                  "INSERT INTO tasks (title, priority, status, "
-                                 "dueDate, creationTime) VALUES (?, ?, "
-                                 "?, ?, unixepoch())");
+                                 "dueDate, creationTime, estimate) VALUES "
+                                 "(?, ?, ?, ?, unixepoch(), ?)");
 
         insert.bind(1, title);
         insert.bind(2, priority);
         insert.bind(3, status);
         insert.bind(4, static_cast<int64_t>(dueDate));
+        insert.bind(5, estimate);
 
         insert.exec();
     } catch (const std::exception &e) {
@@ -193,6 +415,43 @@ std::vector<Task> db::getIncompleteTasksByUser() {
     return tasks;
 }
 
+std::vector<Task> db::getReadyTasks() {
+    auto &db = db::getConnection();
+    std::vector<Task> tasks;
+
+    try {
+        SQLite::Statement select(db,
+                                 "SELECT * FROM tasks "
+                                 "WHERE status IN (0, 1) AND unmet_deps = 0");
+
+        while (select.executeStep()) {
+            tasks.emplace_back(taskFromRow(select));
+        }
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+    }
+    return tasks;
+}
+
+bool db::forEachTask(bool includeComplete,
+                     const std::function<void(Task &&)> &visit) {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Statement select(
+            db, includeComplete ? "SELECT * FROM tasks"
+                                : "SELECT * FROM tasks WHERE status IN (0, 1)");
+
+        while (select.executeStep()) {
+            visit(taskFromRow(select));
+        }
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return false;
+    }
+    return true;
+}
+
 bool db::updateTaskStatus(int id, int status) {
     auto &db = db::getConnection();
 
@@ -256,6 +515,22 @@ bool db::updateTaskTitle(int id, const std::string &title) {
     }
 }
 
+bool db::updateTaskEstimate(int id, int estimate) {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Statement update(db,
+                                 "UPDATE tasks SET estimate = ? WHERE id = ?");
+        update.bind(1, estimate);
+        update.bind(2, id);
+        update.exec();
+        return true;
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return false;
+    }
+}
+
 bool db::deleteTask(int id) {
     auto &db = db::getConnection();
 
@@ -269,3 +544,804 @@ bool db::deleteTask(int id) {
         return false;
     }
 }
+
+namespace {
+void writeTopoRanks(SQLite::Database &db,
+                    const std::vector<TopoRank> &ranks) {
+    SQLite::Statement upsert(db,
+                             "INSERT OR REPLACE INTO task_topo_rank "
+                             "(task_id, rank) VALUES (?, ?)");
+    for (const auto &rank : ranks) {
+        upsert.bind(1, rank.taskId);
+        upsert.bind(2, static_cast<int64_t>(rank.rank));
+        upsert.exec();
+        upsert.reset();
+    }
+}
+
+std::vector<TopoRank> selectTopoRanks(SQLite::Statement &select) {
+    std::vector<TopoRank> ranks;
+    while (select.executeStep()) {
+        ranks.push_back({select.getColumn(0).getInt(),
+                         select.getColumn(1).getInt64()});
+    }
+    return ranks;
+}
+}  // namespace
+
+bool db::addDependency(int taskId, int dependsOn,
+                       const std::vector<TopoRank> &ranks) {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Transaction transaction(db);
+        writeTopoRanks(db, ranks);
+
+        SQLite::Statement insert(db,
+                                 "INSERT INTO task_dependencies "
+                                 "(task_id, depends_on) VALUES (?, ?)");
+        insert.bind(1, taskId);
+        insert.bind(2, dependsOn);
+        insert.exec();
+
+        transaction.commit();
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return false;
+    }
+    return true;
+}
+
+bool db::removeDependency(int taskId, int dependsOn) {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Statement del(db,
+                              "DELETE FROM task_dependencies "
+                              "WHERE task_id = ? AND depends_on = ?");
+        del.bind(1, taskId);
+        del.bind(2, dependsOn);
+        del.exec();
+        return true;
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return false;
+    }
+}
+
+bool db::removeRedundantDependencies(const std::vector<Dependency> &edges) {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Transaction transaction(db);
+
+        // The edge triggers clear both flags; put back what held before
+        SQLite::Statement flags(db,
+                                "SELECT key, value FROM cascade_meta "
+                                "WHERE key IN ('cpm_valid', 'reach_valid')");
+        std::vector<std::pair<std::string, std::int64_t>> saved;
+        while (flags.executeStep()) {
+            saved.emplace_back(flags.getColumn(0).getString(),
+                               flags.getColumn(1).getInt64());
+        }
+
+        SQLite::Statement del(db,
+                              "DELETE FROM task_dependencies "
+                              "WHERE task_id = ? AND depends_on = ?");
+        for (const auto &edge : edges) {
+            del.bind(1, edge.taskId);
+            del.bind(2, edge.dependsOn);
+            del.exec();
+            del.reset();
+        }
+
+        SQLite::Statement restore(
+            db, "UPDATE cascade_meta SET value = ? WHERE key = ?");
+        for (const auto &[key, value] : saved) {
+            restore.bind(1, value);
+            restore.bind(2, key);
+            restore.exec();
+            restore.reset();
+        }
+
+        transaction.commit();
+        return true;
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return false;
+    }
+}
+
+bool db::hasDependency(int taskId, int dependsOn) {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Statement select(db,
+                                 "SELECT 1 FROM task_dependencies "
+                                 "WHERE task_id = ? AND depends_on = ?");
+        select.bind(1, taskId);
+        select.bind(2, dependsOn);
+        return select.executeStep();
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return false;
+    }
+}
+
+std::vector<Dependency> db::getDependencies() {
+    auto &db = db::getConnection();
+    std::vector<Dependency> edges;
+
+    try {
+        SQLite::Statement select(
+            db, "SELECT task_id, depends_on FROM task_dependencies");
+        while (select.executeStep()) {
+            edges.push_back({select.getColumn(0).getInt(),
+                             select.getColumn(1).getInt()});
+        }
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+    }
+    return edges;
+}
+
+bool db::forEachInGraph(
+    const std::vector<int> &roots, bool upstream, bool downstream,
+    const std::function<void(Task &&)> &visitTask,
+    const std::function<void(Dependency)> &visitDependency) {
+    auto &db = db::getConnection();
+
+    try {
+        std::string tasks = "SELECT * FROM tasks";
+        std::string edges = "SELECT task_id, depends_on FROM task_dependencies";
+        if (!roots.empty()) {
+            // Collect the subgraph once into a keyed temp table, so keeping
+            // only edges with both endpoints inside is one lookup per end
+            db.exec("DROP TABLE IF EXISTS temp.export_subgraph");
+            db.exec(
+                "CREATE TEMP TABLE export_subgraph "
+                "(id INTEGER PRIMARY KEY)");
+            SQLite::Statement collect(
+                db, subgraphCte(roots.size(), upstream, downstream) +
+                        "INSERT INTO temp.export_subgraph "
+                        "SELECT id FROM subgraph");
+            bindRoots(collect, roots);
+            collect.exec();
+
+            tasks =
+                "SELECT t.* FROM temp.export_subgraph s "
+                "JOIN tasks t ON t.id = s.id";
+            edges =
+                "SELECT d.task_id, d.depends_on FROM temp.export_subgraph s "
+                "JOIN task_dependencies d ON d.depends_on = s.id "
+                "JOIN temp.export_subgraph w ON w.id = d.task_id";
+        }
+
+        SQLite::Statement selectTasks(db, tasks);
+        while (selectTasks.executeStep()) {
+            visitTask(taskFromRow(selectTasks));
+        }
+        SQLite::Statement selectEdges(db, edges);
+        while (selectEdges.executeStep()) {
+            visitDependency({selectEdges.getColumn(0).getInt(),
+                             selectEdges.getColumn(1).getInt()});
+        }
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return false;
+    }
+    return true;
+}
+
+std::vector<TaskAtDepth> db::getNeighbourhood(int taskId,
+                                              ReachDirection direction,
+                                              int maxDepth) {
+    auto &db = db::getConnection();
+    std::vector<TaskAtDepth> tasks;
+
+    try {
+        // Each step is one index lookup: the primary key for prerequisites,
+        // task_dependencies_depends_on for dependents. UNION drops repeated
+        // (id, depth) rows and the depth bound ends every path, so the walk
+        // terminates even if an edge edited in by hand closed a cycle.
+        bool downstream = direction == ReachDirection::Downstream;
+        SQLite::Statement select(
+            db, std::format("WITH RECURSIVE walk(id, depth) AS ("
+                            "SELECT ?1, 0 "
+                            "UNION "
+                            "SELECT d.{1}, w.depth + 1 FROM walk w "
+                            "JOIN task_dependencies d ON d.{0} = w.id "
+                            "WHERE w.depth < ?2) "
+                            "SELECT t.*, MIN(w.depth) AS depth FROM walk w "
+                            "JOIN tasks t ON t.id = w.id "
+                            "WHERE w.id != ?1 "
+                            "GROUP BY t.id ORDER BY depth, t.id",
+                            downstream ? "depends_on" : "task_id",
+                            downstream ? "task_id" : "depends_on"));
+        select.bind(1, taskId);
+        select.bind(2, maxDepth);
+        while (select.executeStep()) {
+            tasks.push_back(
+                {taskFromRow(select), select.getColumn("depth").getInt()});
+        }
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+    }
+    return tasks;
+}
+
+bool db::isTopoRanked() {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Statement select(
+            db, "SELECT value FROM cascade_meta WHERE key = 'topo_ranked'");
+        return select.executeStep() && select.getColumn(0).getInt() != 0;
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return false;
+    }
+}
+
+bool db::saveTopoRanks(const std::vector<TopoRank> &ranks) {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Transaction transaction(db);
+        db.exec("DELETE FROM task_topo_rank");
+        writeTopoRanks(db, ranks);
+        db.exec(
+            "UPDATE cascade_meta SET value = 1 WHERE key = 'topo_ranked'");
+        transaction.commit();
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return false;
+    }
+    return true;
+}
+
+std::optional<std::int64_t> db::getTopoRank(int taskId) {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Statement select(
+            db, "SELECT rank FROM task_topo_rank WHERE task_id = ?");
+        select.bind(1, taskId);
+        if (select.executeStep()) {
+            return select.getColumn(0).getInt64();
+        }
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+    }
+    return std::nullopt;
+}
+
+std::optional<std::pair<std::int64_t, std::int64_t>> db::getTopoRankRange() {
+    auto &db = db::getConnection();
+
+    try {
+        // SQLite answers a lone MIN or MAX from an index but scans the
+        // table for both in one SELECT, hence the two subqueries
+        SQLite::Statement select(
+            db,
+            "SELECT (SELECT MIN(rank) FROM task_topo_rank), "
+            "(SELECT MAX(rank) FROM task_topo_rank)");
+        if (select.executeStep() && !select.getColumn(0).isNull()) {
+            return std::pair{select.getColumn(0).getInt64(),
+                             select.getColumn(1).getInt64()};
+        }
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+    }
+    return std::nullopt;
+}
+
+std::vector<TopoRank> db::getDependentsRankedUpTo(int taskId,
+                                                  std::int64_t bound) {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Statement select(
+            db,
+            "SELECT d.task_id, r.rank "
+            "FROM task_dependencies d "
+            "JOIN task_topo_rank r ON r.task_id = d.task_id "
+            "WHERE d.depends_on = ? AND r.rank <= ?");
+        select.bind(1, taskId);
+        select.bind(2, static_cast<int64_t>(bound));
+        return selectTopoRanks(select);
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return {};
+    }
+}
+
+std::vector<TopoRank> db::getPrerequisitesRankedFrom(int taskId,
+                                                     std::int64_t bound) {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Statement select(
+            db,
+            "SELECT d.depends_on, r.rank "
+            "FROM task_dependencies d "
+            "JOIN task_topo_rank r ON r.task_id = d.depends_on "
+            "WHERE d.task_id = ? AND r.rank >= ?");
+        select.bind(1, taskId);
+        select.bind(2, static_cast<int64_t>(bound));
+        return selectTopoRanks(select);
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return {};
+    }
+}
+
+namespace {
+std::vector<CpmNode> selectCpmNodes(SQLite::Statement &select) {
+    std::vector<CpmNode> nodes;
+    while (select.executeStep()) {
+        nodes.push_back({select.getColumn(0).getInt(),
+                         select.getColumn(1).getInt64(),
+                         select.getColumn(2).getInt(),
+                         select.getColumn(3).getInt64(),
+                         select.getColumn(4).getInt64()});
+    }
+    return nodes;
+}
+}  // namespace
+
+bool db::isCpmValid() {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Statement select(
+            db, "SELECT value FROM cascade_meta WHERE key = 'cpm_valid'");
+        return select.executeStep() && select.getColumn(0).getInt() != 0;
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return false;
+    }
+}
+
+bool db::saveCpmTimes(const std::vector<CpmNode> &nodes, bool replaceAll) {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Transaction transaction(db);
+        if (replaceAll) {
+            db.exec("DELETE FROM task_cpm");
+        }
+
+        SQLite::Statement upsert(db,
+                                 "INSERT OR REPLACE INTO task_cpm "
+                                 "(task_id, earliest_start, remaining) "
+                                 "VALUES (?, ?, ?)");
+        for (const auto &node : nodes) {
+            upsert.bind(1, node.taskId);
+            upsert.bind(2, static_cast<int64_t>(node.earliestStart));
+            upsert.bind(3, static_cast<int64_t>(node.remaining));
+            upsert.exec();
+            upsert.reset();
+        }
+
+        db.exec("UPDATE cascade_meta SET value = 1 WHERE key = 'cpm_valid'");
+        transaction.commit();
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return false;
+    }
+    return true;
+}
+
+std::vector<CpmNode> db::getCpmNodes() {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Statement select(db,
+                                 "SELECT * FROM task_cpm_nodes ORDER BY rank");
+        return selectCpmNodes(select);
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return {};
+    }
+}
+
+std::vector<TaskCpm> db::getCpmTasks() {
+    auto &db = db::getConnection();
+    std::vector<TaskCpm> tasks;
+
+    try {
+        // taskFromRow reads the leading task columns; the node's columns
+        // are read by name
+        SQLite::Statement select(
+            db,
+            "SELECT t.*, n.rank, n.duration, n.earliest_start, n.remaining "
+            "FROM task_cpm_nodes n JOIN tasks t ON t.id = n.task_id "
+            "ORDER BY n.rank");
+        while (select.executeStep()) {
+            Task task = taskFromRow(select);
+            CpmNode node{task.id, select.getColumn("rank").getInt64(),
+                         select.getColumn("duration").getInt(),
+                         select.getColumn("earliest_start").getInt64(),
+                         select.getColumn("remaining").getInt64()};
+            tasks.push_back({std::move(task), node});
+        }
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+    }
+    return tasks;
+}
+
+std::optional<CpmNode> db::getCpmNode(int taskId) {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Statement select(
+            db, "SELECT * FROM task_cpm_nodes WHERE task_id = ?");
+        select.bind(1, taskId);
+        auto nodes = selectCpmNodes(select);
+        if (!nodes.empty()) {
+            return nodes.front();
+        }
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+    }
+    return std::nullopt;
+}
+
+std::vector<CpmNode> db::getCpmPrerequisites(int taskId) {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Statement select(db,
+                                 "SELECT n.* FROM task_dependencies d "
+                                 "JOIN task_cpm_nodes n "
+                                 "ON n.task_id = d.depends_on "
+                                 "WHERE d.task_id = ?");
+        select.bind(1, taskId);
+        return selectCpmNodes(select);
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return {};
+    }
+}
+
+std::vector<CpmNode> db::getCpmDependents(int taskId) {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Statement select(db,
+                                 "SELECT n.* FROM task_dependencies d "
+                                 "JOIN task_cpm_nodes n "
+                                 "ON n.task_id = d.task_id "
+                                 "WHERE d.depends_on = ?");
+        select.bind(1, taskId);
+        return selectCpmNodes(select);
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return {};
+    }
+}
+
+namespace {
+void writeReachSets(SQLite::Database &db, const std::vector<ReachSet> &sets) {
+    SQLite::Statement clear(db,
+                            "DELETE FROM task_reach "
+                            "WHERE slot = ? AND direction = ?");
+    SQLite::Statement insert(db,
+                             "INSERT INTO task_reach "
+                             "(slot, direction, chunk, bits) "
+                             "VALUES (?, ?, ?, ?)");
+    for (const auto &set : sets) {
+        clear.bind(1, set.slot);
+        clear.bind(2, static_cast<int>(set.direction));
+        clear.exec();
+        clear.reset();
+
+        for (const auto &chunk : set.chunks) {
+            insert.bind(1, set.slot);
+            insert.bind(2, static_cast<int>(set.direction));
+            insert.bind(3, chunk.index);
+            insert.bind(4, chunk.words.data(),
+                        static_cast<int>(chunk.words.size() *
+                                         sizeof(std::uint64_t)));
+            insert.exec();
+            insert.reset();
+        }
+    }
+}
+
+std::vector<std::uint64_t> wordsFromBlob(const SQLite::Column &column) {
+    std::vector<std::uint64_t> words(column.getBytes() /
+                                     sizeof(std::uint64_t));
+    std::memcpy(words.data(), column.getBlob(),
+                words.size() * sizeof(std::uint64_t));
+    return words;
+}
+}  // namespace
+
+bool db::isReachValid() {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Statement select(
+            db, "SELECT value FROM cascade_meta WHERE key = 'reach_valid'");
+        return select.executeStep() && select.getColumn(0).getInt() != 0;
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return false;
+    }
+}
+
+bool db::rebuildReachIndex(
+    const std::vector<std::pair<int, std::uint32_t>> &slots,
+    const std::vector<ReachSet> &sets) {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Transaction transaction(db);
+        db.exec("DELETE FROM task_reach_slot");
+
+        SQLite::Statement insert(db,
+                                 "INSERT INTO task_reach_slot "
+                                 "(task_id, slot) VALUES (?, ?)");
+        for (const auto &[taskId, slot] : slots) {
+            insert.bind(1, taskId);
+            insert.bind(2, slot);
+            insert.exec();
+            insert.reset();
+        }
+        writeReachSets(db, sets);
+
+        db.exec("UPDATE cascade_meta SET value = 1 WHERE key = 'reach_valid'");
+        transaction.commit();
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return false;
+    }
+    return true;
+}
+
+bool db::saveReachSets(const std::vector<ReachSet> &sets) {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Transaction transaction(db);
+        writeReachSets(db, sets);
+        db.exec("UPDATE cascade_meta SET value = 1 WHERE key = 'reach_valid'");
+        transaction.commit();
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return false;
+    }
+    return true;
+}
+
+std::optional<std::uint32_t> db::getReachSlot(int taskId) {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Statement select(
+            db, "SELECT slot FROM task_reach_slot WHERE task_id = ?");
+        select.bind(1, taskId);
+        if (select.executeStep()) {
+            return select.getColumn(0).getUInt();
+        }
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+    }
+    return std::nullopt;
+}
+
+std::optional<std::uint32_t> db::assignReachSlot(int taskId) {
+    if (auto slot = getReachSlot(taskId)) {
+        return slot;
+    }
+
+    auto &db = db::getConnection();
+    try {
+        SQLite::Statement insert(db,
+                                 "INSERT INTO task_reach_slot (task_id, slot) "
+                                 "SELECT ?, COALESCE(MAX(slot) + 1, 0) "
+                                 "FROM task_reach_slot");
+        insert.bind(1, taskId);
+        insert.exec();
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return std::nullopt;
+    }
+    return getReachSlot(taskId);
+}
+
+std::vector<ReachChunk> db::getReachChunks(std::uint32_t slot,
+                                           ReachDirection direction) {
+    auto &db = db::getConnection();
+    std::vector<ReachChunk> chunks;
+
+    try {
+        SQLite::Statement select(db,
+                                 "SELECT chunk, bits FROM task_reach "
+                                 "WHERE slot = ? AND direction = ?");
+        select.bind(1, slot);
+        select.bind(2, static_cast<int>(direction));
+        while (select.executeStep()) {
+            chunks.push_back({select.getColumn(0).getUInt(),
+                              wordsFromBlob(select.getColumn(1))});
+        }
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+    }
+    return chunks;
+}
+
+std::vector<RankedSlot> db::getReachNeighbours(std::uint32_t slot,
+                                               ReachDirection direction) {
+    auto &db = db::getConnection();
+    std::vector<RankedSlot> slots;
+
+    try {
+        // Downstream neighbours are dependents, upstream ones prerequisites
+        bool downstream = direction == ReachDirection::Downstream;
+        SQLite::Statement select(
+            db, std::format("SELECT n.slot, r.rank FROM task_reach_slot s "
+                            "JOIN task_dependencies d ON d.{0} = s.task_id "
+                            "JOIN task_reach_slot n ON n.task_id = d.{1} "
+                            "JOIN task_topo_rank r ON r.task_id = d.{1} "
+                            "WHERE s.slot = ?",
+                            downstream ? "depends_on" : "task_id",
+                            downstream ? "task_id" : "depends_on"));
+        select.bind(1, slot);
+        while (select.executeStep()) {
+            slots.push_back({select.getColumn(0).getUInt(),
+                             select.getColumn(1).getInt64()});
+        }
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+    }
+    return slots;
+}
+
+std::optional<std::int64_t> db::getReachSlotRank(std::uint32_t slot) {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Statement select(
+            db,
+            "SELECT r.rank FROM task_reach_slot s "
+            "JOIN task_topo_rank r ON r.task_id = s.task_id "
+            "WHERE s.slot = ?");
+        select.bind(1, slot);
+        if (select.executeStep()) {
+            return select.getColumn(0).getInt64();
+        }
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+    }
+    return std::nullopt;
+}
+
+std::optional<bool> db::isReachable(int fromTaskId, int toTaskId) {
+    auto &db = db::getConnection();
+
+    try {
+        // One chunk of the source's downstream set, picked by the target's
+        // slot; a missing chunk means no bit in it is set
+        SQLite::Statement select(
+            db, std::format("SELECT t.slot, r.bits FROM task_reach_slot f "
+                            "JOIN task_reach_slot t ON t.task_id = ? "
+                            "LEFT JOIN task_reach r ON r.slot = f.slot "
+                            "AND r.direction = 0 AND r.chunk = t.slot / {} "
+                            "WHERE f.task_id = ?",
+                            REACH_CHUNK_BITS));
+        select.bind(1, toTaskId);
+        select.bind(2, fromTaskId);
+        if (!select.executeStep()) {
+            return false;
+        }
+        if (select.getColumn(1).isNull()) {
+            return false;
+        }
+
+        std::uint32_t bit = select.getColumn(0).getUInt() % REACH_CHUNK_BITS;
+        auto words = wordsFromBlob(select.getColumn(1));
+        return bit / 64 < words.size() && (words[bit / 64] >> (bit % 64)) & 1;
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return std::nullopt;
+    }
+}
+
+std::vector<Task> db::getTasksBySlots(const std::vector<std::uint32_t> &slots) {
+    auto &db = db::getConnection();
+    std::vector<Task> tasks;
+
+    try {
+        SQLite::Statement select(db,
+                                 "SELECT t.* FROM task_reach_slot s "
+                                 "JOIN tasks t ON t.id = s.task_id "
+                                 "WHERE s.slot = ?");
+        for (std::uint32_t slot : slots) {
+            select.bind(1, slot);
+            if (select.executeStep()) {
+                tasks.emplace_back(taskFromRow(select));
+            }
+            select.reset();
+        }
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+    }
+    return tasks;
+}
+
+std::int64_t db::getTasksVersion() {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Statement select(
+            db, "SELECT value FROM cascade_meta WHERE key = 'tasks_version'");
+        if (select.executeStep()) {
+            return select.getColumn(0).getInt64();
+        }
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+    }
+    return -1;
+}
+
+std::optional<std::vector<Task>> db::getQueueSnapshot(std::int64_t version) {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Statement check(db,
+                                "SELECT value FROM cascade_meta "
+                                "WHERE key = 'snapshot_version'");
+        if (!check.executeStep() || check.getColumn(0).getInt64() != version) {
+            return std::nullopt;
+        }
+
+        std::vector<Task> tasks;
+        SQLite::Statement select(db,
+                                 "SELECT t.* FROM task_queue_snapshot s "
+                                 "JOIN tasks t ON t.id = s.task_id "
+                                 "ORDER BY s.rank");
+        while (select.executeStep()) {
+            tasks.emplace_back(taskFromRow(select));
+        }
+        return tasks;
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return std::nullopt;
+    }
+}
+
+bool db::saveQueueSnapshot(std::int64_t version,
+                           const std::vector<Task> &tasks) {
+    auto &db = db::getConnection();
+
+    try {
+        SQLite::Transaction transaction(db);
+        db.exec("DELETE FROM task_queue_snapshot");
+
+        SQLite::Statement insert(db,
+                                 "INSERT INTO task_queue_snapshot "
+                                 "(rank, task_id) VALUES (?, ?)");
+        for (std::size_t rank = 0; rank < tasks.size(); rank++) {
+            insert.bind(1, static_cast<int64_t>(rank));
+            insert.bind(2, tasks[rank].id);
+            insert.exec();
+            insert.reset();
+        }
+
+        SQLite::Statement update(
+            db,
+            "UPDATE cascade_meta SET value = ? WHERE key = 'snapshot_version'");
+        update.bind(1, static_cast<int64_t>(version));
+        update.exec();
+
+        transaction.commit();
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,282 @@
+#include "externalSort.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "models.h"
+#include "sortspec.h"
+
+namespace {
+// I/O buffer per run being written or merged, taken from the budget
+constexpr std::size_t MAX_RUN_BUFFER = 1 << 16;
+constexpr std::size_t MIN_RUN_BUFFER = 1 << 12;
+constexpr std::size_t RUN_BUFFER_SHARE = 64;
+
+// Run files hold fixed-width fields followed by the raw title bytes:
+// id, priority, status, estimate (int32), dueDate, creationTime (int64),
+// title length (uint32), title.
+template <class T>
+void writeValue(std::FILE* file, T value) {
+    if (std::fwrite(&value, sizeof(value), 1, file) != 1) {
+        throw std::runtime_error("Failed to write sort run");
+    }
+}
+
+// Reads one run back from a spill file through its own buffer. Every read
+// seeks first, so any number of runs can share one FILE.
+class RunReader {
+   public:
+    RunReader(std::FILE* file, long begin, long end, std::size_t bufferSize)
+        : file(file), position(begin), end(end), buffer(bufferSize) {}
+
+    bool atEnd() const { return next == filled && position == end; }
+
+    // False if the run ends before `size` bytes were read
+    bool read(void* out, std::size_t size) {
+        auto* bytes = static_cast<char*>(out);
+        while (size > 0) {
+            if (next == filled && !refill()) {
+                return false;
+            }
+            std::size_t count = std::min(size, filled - next);
+            std::copy_n(buffer.data() + next, count, bytes);
+            next += count;
+            bytes += count;
+            size -= count;
+        }
+        return true;
+    }
+
+   private:
+    std::FILE* file;
+    long position;
+    long end;
+    std::vector<char> buffer;
+    std::size_t next = 0;
+    std::size_t filled = 0;
+
+    bool refill() {
+        std::size_t count = std::min(buffer.size(),
+                                     static_cast<std::size_t>(end - position));
+        if (count == 0) {
+            return false;
+        }
+        if (std::fseek(file, position, SEEK_SET) != 0 ||
+            std::fread(buffer.data(), 1, count, file) != count) {
+            throw std::runtime_error("Failed to read sort run");
+        }
+        position += static_cast<long>(count);
+        next = 0;
+        filled = count;
+        return true;
+    }
+};
+
+template <class T>
+bool readValue(RunReader& reader, T& value) {
+    return reader.read(&value, sizeof(value));
+}
+
+void writeTask(std::FILE* file, const Task& task) {
+    writeValue<std::int32_t>(file, task.id);
+    writeValue<std::int32_t>(file, task.priority);
+    writeValue<std::int32_t>(file, task.status);
+    writeValue<std::int32_t>(file, task.estimate);
+    writeValue<std::int64_t>(file, task.dueDate);
+    writeValue<std::int64_t>(file, task.creationTime);
+    writeValue<std::uint32_t>(file, task.title.size());
+    if (!task.title.empty() &&
+        std::fwrite(task.title.data(), 1, task.title.size(), file) !=
+            task.title.size()) {
+        throw std::runtime_error("Failed to write sort run");
+    }
+}
+
+std::optional<Task> readTask(RunReader& reader) {
+    std::int32_t id;
+    std::int32_t priority;
+    std::int32_t status;
+    std::int32_t estimate;
+    std::int64_t dueDate;
+    std::int64_t creationTime;
+    std::uint32_t titleLength;
+
+    if (reader.atEnd()) {
+        return std::nullopt;
+    }
+    if (!readValue(reader, id) || !readValue(reader, priority) ||
+        !readValue(reader, status) || !readValue(reader, estimate) ||
+        !readValue(reader, dueDate) || !readValue(reader, creationTime) ||
+        !readValue(reader, titleLength)) {
+        throw std::runtime_error("Truncated sort run");
+    }
+
+    Task task;
+    task.id = id;
+    task.priority = priority;
+    task.status = status;
+    task.estimate = estimate;
+    task.dueDate = dueDate;
+    task.creationTime = creationTime;
+    task.title.resize(titleLength);
+    if (titleLength > 0 && !reader.read(task.title.data(), titleLength)) {
+        throw std::runtime_error("Truncated sort run");
+    }
+    return task;
+}
+}  // namespace
+
+core::ExternalSorter::ExternalSorter(const SortSpec& spec,
+                                     std::size_t memoryBudget)
+    : spec(spec), comparator(spec), memoryBudget(memoryBudget) {}
+
+void core::ExternalSorter::add(Task task) {
+    std::size_t bytes = footprint(task);
+    if (!buffer.empty() && bufferedBytes + bytes > memoryBudget) {
+        spill();
+    }
+
+    bufferedBytes += bytes;
+    buffer.emplace_back(std::move(task));
+}
+
+void core::ExternalSorter::finish(
+    const std::function<void(const Task&)>& emit) {
+    if (runs.empty()) {
+        for (auto index : sortedOrder(buffer, spec)) {
+            emit(buffer[index]);
+        }
+        buffer.clear();
+        return;
+    }
+
+    if (!buffer.empty()) {
+        spill();
+    }
+    buffer.shrink_to_fit();
+
+    // Each pass merges groups of consecutive runs into one run each, in a
+    // new file, until a single merge can take every run. Groups keep their
+    // order, so ties still come out in input order.
+    std::size_t fanIn = maxFanIn();
+    while (runs.size() > fanIn) {
+        RunFile merged = createRunFile();
+        std::vector<Run> mergedRuns;
+        for (std::size_t first = 0; first < runs.size(); first += fanIn) {
+            long begin = std::ftell(merged.get());
+            mergeRuns(std::span<const Run>(runs).subspan(
+                          first, std::min(fanIn, runs.size() - first)),
+                      [&merged](const Task& task) {
+                          writeTask(merged.get(), task);
+                      });
+            mergedRuns.push_back({begin, std::ftell(merged.get())});
+        }
+        if (std::fflush(merged.get()) != 0) {
+            throw std::runtime_error("Failed to write sort run");
+        }
+
+        spillFile = std::move(merged);
+        runs = std::move(mergedRuns);
+    }
+
+    mergeRuns(runs, emit);
+    runs.clear();
+    spillFile.reset();
+}
+
+std::size_t core::ExternalSorter::getRunCount() const { return runs.size(); }
+
+std::size_t core::ExternalSorter::footprint(const Task& task) {
+    // The index slot comes from sortedOrder's permutation
+    return sizeof(Task) + task.title.capacity() + sizeof(std::uint32_t);
+}
+
+std::size_t core::ExternalSorter::runBufferSize() const {
+    return std::clamp(memoryBudget / RUN_BUFFER_SHARE, MIN_RUN_BUFFER,
+                      MAX_RUN_BUFFER);
+}
+
+// Runs one merge can read at once with a buffer each, keeping one buffer
+// back for the output of an intermediate pass
+std::size_t core::ExternalSorter::maxFanIn() const {
+    return std::max<std::size_t>(2, memoryBudget / runBufferSize() - 1);
+}
+
+core::ExternalSorter::RunFile core::ExternalSorter::createRunFile() const {
+    RunFile file(std::tmpfile());
+    if (!file) {
+        throw std::runtime_error("Failed to create temporary sort run");
+    }
+    std::setvbuf(file.get(), nullptr, _IOFBF, runBufferSize());
+    return file;
+}
+
+void core::ExternalSorter::spill() {
+    if (!spillFile) {
+        spillFile = createRunFile();
+    }
+
+    long begin = std::ftell(spillFile.get());
+    for (auto index : sortedOrder(buffer, spec)) {
+        writeTask(spillFile.get(), buffer[index]);
+    }
+    if (std::fflush(spillFile.get()) != 0) {
+        throw std::runtime_error("Failed to write sort run");
+    }
+
+    runs.push_back({begin, std::ftell(spillFile.get())});
+    buffer.clear();
+    bufferedBytes = 0;
+}
+
+void core::ExternalSorter::mergeRuns(
+    std::span<const Run> group,
+    const std::function<void(const Task&)>& emit) const {
+    std::vector<RunReader> readers;
+    readers.reserve(group.size());
+    std::vector<std::optional<Task>> heads;
+    heads.reserve(group.size());
+    for (const auto& run : group) {
+        readers.emplace_back(spillFile.get(), run.begin, run.end,
+                             runBufferSize());
+        heads.push_back(readTask(readers.back()));
+    }
+
+    // Min-heap of run numbers by head task; equal heads pop in run order,
+    // which is input order, so the merge stays stable.
+    auto later = [&](std::size_t a, std::size_t b) {
+        if (comparator(*heads[b], *heads[a])) {
+            return true;
+        }
+        if (comparator(*heads[a], *heads[b])) {
+            return false;
+        }
+        return a > b;
+    };
+    std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(later)>
+        heap(later);
+    for (std::size_t run = 0; run < group.size(); run++) {
+        if (heads[run].has_value()) {
+            heap.push(run);
+        }
+    }
+
+    while (!heap.empty()) {
+        std::size_t run = heap.top();
+        heap.pop();
+        emit(*heads[run]);
+
+        heads[run] = readTask(readers[run]);
+        if (heads[run].has_value()) {
+            heap.push(run);
+        }
+    }
+}
@@ -0,0 +1,196 @@
+#include "graphExport.h"
+
+#include <cstdio>
+#include <format>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "models.h"
+
+namespace {
+constexpr std::string_view GRAPHML_HEADER =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\">\n"
+    "  <key id=\"title\" for=\"node\" attr.name=\"title\" "
+    "attr.type=\"string\"/>\n"
+    "  <key id=\"priority\" for=\"node\" attr.name=\"priority\" "
+    "attr.type=\"int\"/>\n"
+    "  <key id=\"status\" for=\"node\" attr.name=\"status\" "
+    "attr.type=\"int\"/>\n"
+    "  <key id=\"estimate\" for=\"node\" attr.name=\"estimate\" "
+    "attr.type=\"int\"/>\n"
+    "  <key id=\"due\" for=\"node\" attr.name=\"due\" attr.type=\"long\"/>\n"
+    "  <graph id=\"cascade\" edgedefault=\"directed\">\n";
+}  // namespace
+
+std::optional<core::ExportFormat> core::parseExportFormat(
+    std::string_view name) {
+    if (name == "dot") {
+        return ExportFormat::Dot;
+    }
+    if (name == "graphml") {
+        return ExportFormat::GraphML;
+    }
+    if (name == "jsonl") {
+        return ExportFormat::Jsonl;
+    }
+    return std::nullopt;
+}
+
+core::GraphExporter::GraphExporter(const std::string& path,
+                                   ExportFormat format)
+    : file(std::fopen(path.c_str(), "wb")), format(format) {
+    if (!file) {
+        throw std::runtime_error("Cannot open " + path + " for writing");
+    }
+    buffer.reserve(BUFFER_SIZE);
+
+    switch (format) {
+        case ExportFormat::Dot:
+            buffer.append("digraph cascade {\n");
+            break;
+        case ExportFormat::GraphML:
+            buffer.append(GRAPHML_HEADER);
+            break;
+        case ExportFormat::Jsonl:
+            break;
+    }
+}
+
+void core::GraphExporter::writeTask(const Task& task) {
+    auto out = std::back_inserter(buffer);
+    switch (format) {
+        case ExportFormat::Dot:
+            std::format_to(out, "  {} [label=\"", task.id);
+            appendEscaped(task.title);
+            std::format_to(out,
+                           "\", priority={}, status={}, estimate={}, "
+                           "due={}];\n",
+                           task.priority, task.status, task.estimate,
+                           task.dueDate);
+            break;
+        case ExportFormat::GraphML:
+            std::format_to(out, "    <node id=\"{}\"><data key=\"title\">",
+                           task.id);
+            appendEscaped(task.title);
+            std::format_to(out,
+                           "</data><data key=\"priority\">{}</data>"
+                           "<data key=\"status\">{}</data>"
+                           "<data key=\"estimate\">{}</data>"
+                           "<data key=\"due\">{}</data></node>\n",
+                           task.priority, task.status, task.estimate,
+                           task.dueDate);
+            break;
+        case ExportFormat::Jsonl:
+            std::format_to(out, "{{\"type\":\"task\",\"id\":{},\"title\":\"",
+                           task.id);
+            appendEscaped(task.title);
+            std::format_to(out,
+                           "\",\"priority\":{},\"status\":{},"
+                           "\"estimate\":{},\"due\":{}}}\n",
+                           task.priority, task.status, task.estimate,
+                           task.dueDate);
+            break;
+    }
+    if (buffer.size() >= BUFFER_SIZE) {
+        writeBuffer();
+    }
+}
+
+void core::GraphExporter::writeDependency(const Dependency& dependency) {
+    auto out = std::back_inserter(buffer);
+    switch (format) {
+        case ExportFormat::Dot:
+            std::format_to(out, "  {} -> {};\n", dependency.dependsOn,
+                           dependency.taskId);
+            break;
+        case ExportFormat::GraphML:
+            std::format_to(out, "    <edge source=\"{}\" target=\"{}\"/>\n",
+                           dependency.dependsOn, dependency.taskId);
+            break;
+        case ExportFormat::Jsonl:
+            std::format_to(out, "{{\"type\":\"edge\",\"from\":{},\"to\":{}}}\n",
+                           dependency.dependsOn, dependency.taskId);
+            break;
+    }
+    if (buffer.size() >= BUFFER_SIZE) {
+        writeBuffer();
+    }
+}
+
+void core::GraphExporter::finish() {
+    switch (format) {
+        case ExportFormat::Dot:
+            buffer.append("}\n");
+            break;
+        case ExportFormat::GraphML:
+            buffer.append("  </graph>\n</graphml>\n");
+            break;
+        case ExportFormat::Jsonl:
+            break;
+    }
+    writeBuffer();
+    if (std::fflush(file.get()) != 0) {
+        throw std::runtime_error("Failed to write export");
+    }
+}
+
+// Titles are free text: quote them for the target syntax. Control
+// characters are not valid XML 1.0, so GraphML replaces them with spaces.
+void core::GraphExporter::appendEscaped(std::string_view text) {
+    for (char c : text) {
+        auto byte = static_cast<unsigned char>(c);
+        switch (format) {
+            case ExportFormat::Dot:
+                if (c == '"' || c == '\\') {
+                    buffer.push_back('\\');
+                    buffer.push_back(c);
+                } else if (c == '\n') {
+                    buffer.append("\\n");
+                } else {
+                    buffer.push_back(c);
+                }
+                break;
+            case ExportFormat::GraphML:
+                if (c == '&') {
+                    buffer.append("&amp;");
+                } else if (c == '<') {
+                    buffer.append("&lt;");
+                } else if (c == '>') {
+                    buffer.append("&gt;");
+                } else if (c == '"') {
+                    buffer.append("&quot;");
+                } else if (byte < 0x20 && c != '\t' && c != '\n') {
+                    buffer.push_back(' ');
+                } else {
+                    buffer.push_back(c);
+                }
+                break;
+            case ExportFormat::Jsonl:
+                if (c == '"' || c == '\\') {
+                    buffer.push_back('\\');
+                    buffer.push_back(c);
+                } else if (byte < 0x20) {
+                    std::format_to(std::back_inserter(buffer), "\\u{:04x}",
+                                   static_cast<unsigned>(byte));
+                } else {
+                    buffer.push_back(c);
+                }
+                break;
+        }
+    }
+}
+
+// Records are small, so the buffer never grows much past BUFFER_SIZE
+// before it is written out
+void core::GraphExporter::writeBuffer() {
+    if (!buffer.empty() &&
+        std::fwrite(buffer.data(), 1, buffer.size(), file.get()) !=
+            buffer.size()) {
+        throw std::runtime_error("Failed to write export");
+    }
+    buffer.clear();
+}
@@ -0,0 +1,81 @@
+#include "listSchedule.h"
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include "DependencyGraph.h"
+#include "cpm.h"
+
+std::optional<core::ListSchedule> core::scheduleWork(
+    const DependencyGraph& graph, std::span<const std::int64_t> durations,
+    std::span<const int> priorities, int workerCount) {
+    auto cpm = computeCpm(graph, durations);
+    if (!cpm.has_value()) {
+        return std::nullopt;
+    }
+
+    using Ready = std::tuple<int, std::int64_t, std::uint32_t>;
+    std::priority_queue<Ready, std::vector<Ready>, std::greater<>> ready;
+    auto release = [&](std::uint32_t v) {
+        ready.emplace(priorities[v], cpm->slack(v), v);
+    };
+
+    // A worker-free event: the worker finishing `vertex` at `time`
+    using Event = std::tuple<std::int64_t, int, std::uint32_t>;
+    std::priority_queue<Event, std::vector<Event>, std::greater<>> events;
+    std::priority_queue<int, std::vector<int>, std::greater<>> idle;
+    for (int worker = 0; worker < workerCount; worker++) {
+        idle.push(worker);
+    }
+
+    std::size_t vertexCount = graph.getVertexCount();
+    std::vector<std::uint32_t> inDegree(vertexCount);
+    for (std::uint32_t v = 0; v < vertexCount; v++) {
+        inDegree[v] = graph.prerequisites(v).size();
+        if (inDegree[v] == 0) {
+            release(v);
+        }
+    }
+
+    ListSchedule schedule;
+    schedule.assignments.reserve(vertexCount);
+    schedule.criticalPath = cpm->length;
+    std::int64_t now = 0;
+
+    while (schedule.assignments.size() < vertexCount || !events.empty()) {
+        while (!ready.empty() && !idle.empty()) {
+            std::uint32_t v = std::get<2>(ready.top());
+            ready.pop();
+            int worker = idle.top();
+            idle.pop();
+
+            std::int64_t finish = now + durations[v];
+            schedule.assignments.push_back({v, worker, now, finish});
+            events.emplace(finish, worker, v);
+        }
+
+        if (events.empty()) {
+            break;
+        }
+        // Free every worker finishing at the next event time before
+        // dispatching, so tasks released together compete on priority
+        now = std::get<0>(events.top());
+        while (!events.empty() && std::get<0>(events.top()) == now) {
+            auto [time, worker, v] = events.top();
+            events.pop();
+            idle.push(worker);
+            for (std::uint32_t next : graph.dependents(v)) {
+                if (--inDegree[next] == 0) {
+                    release(next);
+                }
+            }
+        }
+        schedule.makespan = now;
+    }
+    return schedule;
+}
@@ -77,11 +77,17 @@ int main(int argc, char **argv) {
     task_add->add_option(
         "--due", args.task.dueDate,
         "Due date: YYYY-MM-DD");
+    task_add->add_option("--estimate", args.task.estimate,
+                         "Estimated hours of work. Default: 1");
 
     task_add->callback([&args]() {
+        if (args.task.estimate < 0) {
+            std::println("Estimate cannot be negative.");
+            return;
+        }
         db::createTask(args.task.title, args.task.priority,
                        taskStatusToInt(args.task.status),
-                       parseDate(args.task.dueDate));
+                       parseDate(args.task.dueDate), args.task.estimate);
         std::println("Created task: {}", args.task.title);
     });
 
@@ -98,12 +104,21 @@ int main(int argc, char **argv) {
         "Filter by status: 0=TODO, 1=IN_PROGRESS, 2=COMPLETE, 3=WONT_DO");
     task_list->add_option("--priority", args.task.filterPriority,
                           "Filter by priority level (1-4)");
-    task_list->add_option("--sort", args.task.sortBy,
-                          "Sort by: priority, date (due date), or created");
+    task_list->add_option(
+        "--sort", args.task.sortBy,
+        "Comma-separated sort keys: priority, due (or date), created, "
+        "status, title. Prefix a key with '-' to reverse it, e.g. "
+        "priority,-due");
+
+    task_list->add_option(
+        "--memory-budget", args.task.memoryBudgetMb,
+        "Sort externally in MiB-sized runs spilled to temporary files, for "
+        "task sets larger than memory");
 
     task_list->callback([&args]() {
         repo::listTasks(args.task.showAll, args.task.filterStatus,
-                        args.task.filterPriority, args.task.sortBy);
+                        args.task.filterPriority, args.task.sortBy,
+                        args.task.memoryBudgetMb);
     });
 
 
@@ -141,6 +156,8 @@ int main(int argc, char **argv) {
         "--due", args.task.updateDueDate,
         "New due date: YYYY-MM-DD");
     task_update->add_option("--title", args.task.updateTitle, "New title");
+    task_update->add_option("--estimate", args.task.updateEstimate,
+                            "New estimate in hours");
 
     task_update->callback([&args]() {
         bool updated = false;
@@ -163,10 +180,15 @@ int main(int argc, char **argv) {
             repo::updateTaskTitle(args.task.taskId, args.task.updateTitle);
             updated = true;
         }
+        if (args.task.updateEstimate >= 0) {
+            repo::updateTaskEstimate(args.task.taskId,
+                                     args.task.updateEstimate);
+            updated = true;
+        }
         if (!updated) {
             std::println(
-                "No updates specified. Use --priority, --status, --due, or "
-                "--title.");
+                "No updates specified. Use --priority, --status, --due, "
+                "--title, or --estimate.");
         }
     });
 
@@ -210,6 +232,173 @@ int main(int argc, char **argv) {
                                static_cast<int>(TaskStatus::IN_PROGRESS));
     });
 
+
+
+    auto *deps = app.add_subcommand(
+        "deps",
+        "Task dependency commands\n"
+        "Record which tasks must finish before others can start.");
+    deps->require_subcommand(1);
+
+    auto *deps_add = deps->add_subcommand(
+        "add",
+        "Make a task depend on another\n"
+        "Example:\n"
+        "  cascade deps add 2 1   # task 2 waits for task 1");
+
+    deps_add->add_option("id", args.deps.taskId, "Task that waits")
+        ->required();
+    deps_add->add_option("depends-on", args.deps.dependsOn,
+                         "Task that must finish first")
+        ->required();
+
+    deps_add->callback([&args]() {
+        repo::addDependency(args.deps.taskId, args.deps.dependsOn);
+    });
+
+
+    auto *deps_remove =
+        deps->add_subcommand("remove", "Remove a dependency between tasks\n");
+
+    deps_remove->add_option("id", args.deps.taskId, "Task that waits")
+        ->required();
+    deps_remove->add_option("depends-on", args.deps.dependsOn,
+                            "Task it waits for")
+        ->required();
+
+    deps_remove->callback([&args]() {
+        repo::removeDependency(args.deps.taskId, args.deps.dependsOn);
+    });
+
+
+    auto *deps_show = deps->add_subcommand(
+        "show",
+        "Show what a task depends on and what depends on it\n"
+        "Example:\n"
+        "  cascade deps show 7 --depth 3 --direction up");
+
+    deps_show->add_option("id", args.deps.taskId, "Task ID to inspect")
+        ->required();
+    deps_show->add_option("--depth", args.deps.depth,
+                          "Follow edges this many steps out (default: 1)");
+    deps_show->add_option("--direction", args.deps.direction,
+                          "up (prerequisites) | down (dependents) | both");
+
+    deps_show->callback([&args]() {
+        repo::showDependencies(args.deps.taskId, args.deps.depth,
+                               args.deps.direction);
+    });
+
+
+    auto *deps_export = deps->add_subcommand(
+        "export",
+        "Write the dependency graph to a file for other tools\n"
+        "Edges point from a prerequisite to the task waiting on it.\n"
+        "Example:\n"
+        "  cascade deps export --format graphml -o plan.graphml --root 7");
+
+    deps_export->add_option("--format", args.deps.format,
+                            "dot | graphml | jsonl (default: dot)");
+    deps_export->add_option("-o,--output", args.deps.output, "File to write")
+        ->required();
+    deps_export->add_option("--root", args.deps.roots,
+                            "Only export what this task connects to "
+                            "(repeatable)");
+    deps_export->add_option(
+        "--direction", args.deps.direction,
+        "With --root: follow up (prerequisites), down (dependents), or both");
+
+    deps_export->callback([&args]() {
+        repo::exportDependencies(args.deps.format, args.deps.output,
+                                 args.deps.roots, args.deps.direction);
+    });
+
+
+    auto *deps_reduce = deps->add_subcommand(
+        "reduce",
+        "Find dependencies implied by longer chains\n"
+        "If 3 waits for 2 and 2 waits for 1, then 3 -> 1 is redundant.\n"
+        "Lists them unless --apply is given.");
+
+    deps_reduce->add_flag("--apply", args.deps.apply,
+                          "Remove the redundant dependencies");
+
+    deps_reduce->callback(
+        [&args]() { repo::reduceDependencies(args.deps.apply); });
+
+
+    auto *deps_check = deps->add_subcommand(
+        "check",
+        "Find every dependency cycle\n"
+        "deps add rejects cycles, but edges written by other tools may not.");
+
+    deps_check->callback([]() { repo::checkDependencies(); });
+
+
+    auto *deps_plan = deps->add_subcommand(
+        "plan",
+        "Order incomplete tasks so every task follows its prerequisites\n"
+        "Ready tasks are taken by priority, then due date.");
+
+    deps_plan->callback([]() { repo::showExecutionPlan(); });
+
+
+    auto *deps_critical = deps->add_subcommand(
+        "critical",
+        "Show the critical path: tasks with no slack to finish on time\n"
+        "Times come from task estimates, in hours.");
+
+    deps_critical->add_flag("--all", args.deps.showAll,
+                            "Show every dependent task with its slack");
+
+    deps_critical->callback(
+        [&args]() { repo::showCriticalPath(args.deps.showAll); });
+
+
+    auto *deps_schedule = deps->add_subcommand(
+        "schedule",
+        "Simulate a team working through the incomplete tasks\n"
+        "A free worker takes the ready task with the best priority, then the\n"
+        "least slack. Times come from task estimates, in hours.\n"
+        "Example:\n"
+        "  cascade deps schedule --workers 3");
+
+    deps_schedule->add_option("--workers", args.deps.workers,
+                              "Number of people working (default: 1)");
+
+    deps_schedule->callback(
+        [&args]() { repo::showSchedule(args.deps.workers); });
+
+
+    auto *deps_blocked_by = deps->add_subcommand(
+        "blocked-by",
+        "Show every task a task waits on, directly or transitively\n"
+        "With a second id, only answer whether the first waits on it.\n"
+        "Example:\n"
+        "  cascade deps blocked-by 7 2");
+
+    deps_blocked_by->add_option("id", args.deps.taskId, "Task ID to inspect")
+        ->required();
+    deps_blocked_by->add_option("other", args.deps.dependsOn,
+                                "Task that may block it");
+
+    deps_blocked_by->callback([&args]() {
+        repo::showBlockers(args.deps.taskId, args.deps.dependsOn);
+    });
+
+
+    auto *deps_downstream = deps->add_subcommand(
+        "downstream",
+        "Show every task waiting on a task, directly or transitively\n"
+        "Example:\n"
+        "  cascade deps downstream 2");
+
+    deps_downstream->add_option("id", args.deps.taskId, "Task ID to inspect")
+        ->required();
+
+    deps_downstream->callback(
+        [&args]() { repo::showDownstream(args.deps.taskId); });
+
     CLI11_PARSE(app, argc, argv);
 
     return 0;
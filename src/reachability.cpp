@@ -0,0 +1,163 @@
+#include "reachability.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "ChunkedBitset.h"
+#include "DependencyGraph.h"
+#include "models.h"
+
+namespace {
+using SetKey = std::pair<std::uint32_t, ReachDirection>;
+
+// Sets touched by one update, read through so later steps see earlier ones
+class ReachSets {
+   public:
+    explicit ReachSets(const core::ReachStore& store) : store(store) {}
+
+    core::ChunkedBitset& get(std::uint32_t slot, ReachDirection direction) {
+        auto [it, inserted] = sets.try_emplace({slot, direction});
+        if (inserted) {
+            it->second = core::ChunkedBitset(store.load(slot, direction));
+        }
+        return it->second;
+    }
+
+    void markChanged(std::uint32_t slot, ReachDirection direction) {
+        changed.emplace_back(slot, direction);
+    }
+
+    std::vector<ReachSet> result() {
+        std::sort(changed.begin(), changed.end());
+        changed.erase(std::unique(changed.begin(), changed.end()),
+                      changed.end());
+
+        std::vector<ReachSet> updates;
+        updates.reserve(changed.size());
+        for (const auto& key : changed) {
+            updates.push_back(
+                {key.first, key.second, sets.at(key).toChunks()});
+        }
+        return updates;
+    }
+
+   private:
+    const core::ReachStore& store;
+    std::map<SetKey, core::ChunkedBitset> sets;
+    std::vector<SetKey> changed;
+};
+
+ReachDirection opposite(ReachDirection direction) {
+    return direction == ReachDirection::Downstream ? ReachDirection::Upstream
+                                                   : ReachDirection::Downstream;
+}
+
+// `anchor` gained every slot in `reached` plus `head`, and so did each slot
+// that reaches `anchor` from the other side
+void spreadEdge(ReachSets& sets, std::uint32_t anchor, std::uint32_t head,
+                ReachDirection direction) {
+    core::ChunkedBitset gained = sets.get(head, direction);
+    gained.set(head);
+
+    std::vector<std::uint32_t> targets{anchor};
+    sets.get(anchor, opposite(direction)).forEach([&targets](std::uint32_t s) {
+        targets.push_back(s);
+    });
+
+    for (std::uint32_t slot : targets) {
+        if (sets.get(slot, direction).unionWith(gained)) {
+            sets.markChanged(slot, direction);
+        }
+    }
+}
+
+// Recomputes each set from its direct neighbours, nearest-to-the-end first
+void rebuildSets(const core::ReachStore& store, ReachSets& sets,
+                 std::span<const std::uint32_t> slots,
+                 ReachDirection direction) {
+    std::vector<RankedSlot> order;
+    for (std::uint32_t slot : slots) {
+        if (auto rank = store.rank(slot)) {
+            order.push_back({slot, *rank});
+        }
+    }
+    // Downstream sets read dependents, which rank higher; upstream sets read
+    // prerequisites, which rank lower
+    std::sort(order.begin(), order.end(),
+              [direction](const RankedSlot& a, const RankedSlot& b) {
+                  return direction == ReachDirection::Downstream
+                             ? a.rank > b.rank
+                             : a.rank < b.rank;
+              });
+
+    for (const auto& [slot, rank] : order) {
+        core::ChunkedBitset rebuilt;
+        for (const auto& next : store.neighbours(slot, direction)) {
+            rebuilt.unionWith(sets.get(next.slot, direction));
+            rebuilt.set(next.slot);
+        }
+        core::ChunkedBitset& current = sets.get(slot, direction);
+        if (!(rebuilt == current)) {
+            current = std::move(rebuilt);
+            sets.markChanged(slot, direction);
+        }
+    }
+}
+}  // namespace
+
+std::optional<std::vector<ReachSet>> core::buildReach(
+    const DependencyGraph& graph) {
+    auto order = graph.topologicalOrder();
+    if (!order.has_value()) {
+        return std::nullopt;
+    }
+
+    std::size_t vertexCount = graph.getVertexCount();
+    std::vector<ChunkedBitset> downstream(vertexCount);
+    std::vector<ChunkedBitset> upstream(vertexCount);
+
+    for (auto it = order->rbegin(); it != order->rend(); ++it) {
+        for (std::uint32_t next : graph.dependents(*it)) {
+            downstream[*it].unionWith(downstream[next]);
+            downstream[*it].set(next);
+        }
+    }
+    for (std::uint32_t v : *order) {
+        for (std::uint32_t previous : graph.prerequisites(v)) {
+            upstream[v].unionWith(upstream[previous]);
+            upstream[v].set(previous);
+        }
+    }
+
+    std::vector<ReachSet> sets;
+    sets.reserve(vertexCount * 2);
+    for (std::uint32_t v = 0; v < vertexCount; v++) {
+        sets.push_back(
+            {v, ReachDirection::Downstream, downstream[v].toChunks()});
+        sets.push_back({v, ReachDirection::Upstream, upstream[v].toChunks()});
+    }
+    return sets;
+}
+
+std::vector<ReachSet> core::addReachEdge(const ReachStore& store,
+                                         std::uint32_t from,
+                                         std::uint32_t to) {
+    ReachSets sets(store);
+    spreadEdge(sets, from, to, ReachDirection::Downstream);
+    spreadEdge(sets, to, from, ReachDirection::Upstream);
+    return sets.result();
+}
+
+std::vector<ReachSet> core::recomputeReach(
+    const ReachStore& store, std::span<const std::uint32_t> downstreamSlots,
+    std::span<const std::uint32_t> upstreamSlots) {
+    ReachSets sets(store);
+    rebuildSets(store, sets, downstreamSlots, ReachDirection::Downstream);
+    rebuildSets(store, sets, upstreamSlots, ReachDirection::Upstream);
+    return sets.result();
+}
@@ -1,22 +1,254 @@
 #include "repository.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <exception>
+#include <format>
 #include <iostream>
 #include <optional>
 #include <print>
+#include <span>
+#include <utility>
 #include <vector>
 
+#include "BucketQueue.h"
+#include "ChunkedBitset.h"
+#include "DependencyGraph.h"
 #include "PriorityQueue.h"
+#include "ThreadPool.h"
 #include "commands.h"
+#include "cpm.h"
 #include "database.h"
+#include "externalSort.h"
+#include "graphExport.h"
+#include "listSchedule.h"
 #include "models.h"
-#include "sorting.h"
+#include "reachability.h"
+#include "sortspec.h"
 #include "tabulate.hpp"
+#include "topoOrder.h"
+#include "transitiveReduction.h"
 #include "util.h"
 
-namespace repo {
-core::Queue loadUserTaskQueue() {
-    core::Queue queue;
+namespace {
+// Number of queue heads persisted by `task next`
+constexpr std::size_t NEXT_SNAPSHOT_SIZE = 16;
+// Task ids listed per cell by `deps check`
+constexpr std::size_t CHECK_LIST_LIMIT = 12;
+
+void printTasks(const std::vector<Task> &tasks) {
+    tabulate::Table table;
+    table.add_row({"ID", "Title", "Priority", "Status", "Due Date"});
+    for (const auto &task : tasks) {
+        table.add_row(tabulate::RowStream{} << task.id << task.title
+                                            << task.priority
+                                            << statusToString(task.status)
+                                            << formatDate(task.dueDate));
+    }
+    printStyledTable(table);
+}
+
+void printTasksAtDepth(const std::vector<TaskAtDepth> &tasks) {
+    tabulate::Table table;
+    table.add_row(
+        {"Depth", "ID", "Title", "Priority", "Status", "Due Date"});
+    for (const auto &[task, depth] : tasks) {
+        table.add_row(tabulate::RowStream{}
+                      << depth << task.id << task.title << task.priority
+                      << statusToString(task.status)
+                      << formatDate(task.dueDate));
+    }
+    printStyledTable(table);
+}
+
+// Dependency graph over the incomplete tasks; edges to finished tasks are
+// already satisfied and drop out. byVertex maps graph vertices to tasks.
+struct OpenGraph {
+    std::vector<Task> tasks;
+    std::vector<const Task *> byVertex;
+    core::DependencyGraph graph;
+};
+
+OpenGraph loadOpenGraph() {
     auto tasks = db::getIncompleteTasksByUser();
+    auto edges = db::getDependencies();
+
+    std::vector<int> ids;
+    ids.reserve(tasks.size());
+    for (const auto &task : tasks) {
+        ids.push_back(task.id);
+    }
+    core::DependencyGraph graph(std::move(ids), edges);
+
+    std::vector<const Task *> byVertex(graph.getVertexCount());
+    for (const auto &task : tasks) {
+        byVertex[graph.indexOf(task.id).value()] = &task;
+    }
+    return {std::move(tasks), std::move(byVertex), std::move(graph)};
+}
+
+// Ranks every task with an edge from one full sort. Runs once, for edges
+// added before ranks were kept.
+bool rankExistingDependencies() {
+    auto edges = db::getDependencies();
+    auto graph = core::DependencyGraph::fromEdges(edges);
+    auto order = graph.topologicalOrder();
+    if (!order.has_value()) {
+        std::println("Dependencies contain a cycle; cannot rank tasks.");
+        return false;
+    }
+
+    std::vector<TopoRank> ranks;
+    ranks.reserve(order->size());
+    for (std::size_t rank = 0; rank < order->size(); rank++) {
+        ranks.push_back({graph.taskIdAt((*order)[rank]),
+                         static_cast<std::int64_t>(rank)});
+    }
+    return db::saveTopoRanks(ranks);
+}
+
+std::vector<int> taskIds(const std::vector<CpmNode> &nodes) {
+    std::vector<int> ids;
+    ids.reserve(nodes.size());
+    for (const auto &node : nodes) {
+        ids.push_back(node.taskId);
+    }
+    return ids;
+}
+
+// Full forward and backward CPM passes over every ranked task
+bool rebuildCpm() {
+    auto nodes = db::getCpmNodes();
+    auto edges = db::getDependencies();
+    core::DependencyGraph graph(taskIds(nodes), edges);
+
+    std::vector<std::int64_t> durations(graph.getVertexCount());
+    for (const auto &node : nodes) {
+        durations[graph.indexOf(node.taskId).value()] = node.duration;
+    }
+
+    auto schedule =
+        core::computeCpm(graph, durations, core::ThreadPool::shared());
+    if (!schedule.has_value()) {
+        std::println("Dependencies contain a cycle; no critical path.");
+        return false;
+    }
+
+    for (auto &node : nodes) {
+        auto vertex = graph.indexOf(node.taskId).value();
+        node.earliestStart = schedule->earliestStart[vertex];
+        node.remaining = schedule->remaining[vertex];
+    }
+    return db::saveCpmTimes(nodes, true);
+}
+
+// Brings the persisted CPM times up to date after an edit. If they were
+// already stale before it, the next `deps critical` rebuilds them instead.
+void refreshCpm(bool wasValid, std::span<const int> startSeeds,
+                std::span<const int> remainingSeeds) {
+    if (!wasValid) {
+        return;
+    }
+
+    core::CpmStore store{db::getCpmNode, db::getCpmPrerequisites,
+                         db::getCpmDependents};
+    db::saveCpmTimes(core::propagateCpm(store, startSeeds, remainingSeeds),
+                     false);
+}
+
+core::ReachStore reachStore() {
+    return {db::getReachChunks, db::getReachNeighbours, db::getReachSlotRank};
+}
+
+std::vector<std::uint32_t> reachableSlots(std::uint32_t slot,
+                                          ReachDirection direction) {
+    std::vector<std::uint32_t> slots;
+    core::ChunkedBitset(db::getReachChunks(slot, direction))
+        .forEach([&slots](std::uint32_t reached) { slots.push_back(reached); });
+    return slots;
+}
+
+// Full transitive closure over every task with an edge
+bool rebuildReach() {
+    auto edges = db::getDependencies();
+    auto graph = core::DependencyGraph::fromEdges(edges);
+    auto sets = core::buildReach(graph);
+    if (!sets.has_value()) {
+        std::println("Dependencies contain a cycle; cannot index them.");
+        return false;
+    }
+
+    std::vector<std::pair<int, std::uint32_t>> slots;
+    slots.reserve(graph.getVertexCount());
+    for (std::uint32_t v = 0; v < graph.getVertexCount(); v++) {
+        slots.emplace_back(graph.taskIdAt(v), v);
+    }
+    return db::rebuildReachIndex(slots, *sets);
+}
+
+bool ensureReachIndex() {
+    if (!db::isTopoRanked() && !rankExistingDependencies()) {
+        return false;
+    }
+    return db::isReachValid() || rebuildReach();
+}
+
+// The three refreshers below run after an edit and do nothing if the index
+// was already stale before it; the next query rebuilds it instead
+void refreshReach(bool wasValid, std::span<const std::uint32_t> downstreamOf,
+                  std::span<const std::uint32_t> upstreamOf) {
+    if (wasValid) {
+        db::saveReachSets(
+            core::recomputeReach(reachStore(), downstreamOf, upstreamOf));
+    }
+}
+
+void refreshReachAfterAdd(bool wasValid, int from, int to) {
+    if (!wasValid) {
+        return;
+    }
+    auto fromSlot = db::assignReachSlot(from);
+    auto toSlot = db::assignReachSlot(to);
+    if (fromSlot.has_value() && toSlot.has_value()) {
+        db::saveReachSets(core::addReachEdge(reachStore(), *fromSlot, *toSlot));
+    }
+}
+
+// Removing from -> to changes the downstream sets of `from` and its
+// ancestors, and the upstream sets of `to` and its descendants
+void refreshReachAfterRemove(bool wasValid, int from, int to) {
+    if (!wasValid) {
+        return;
+    }
+    auto fromSlot = db::getReachSlot(from);
+    auto toSlot = db::getReachSlot(to);
+    if (!fromSlot.has_value() || !toSlot.has_value()) {
+        return;
+    }
+
+    auto ancestors = reachableSlots(*fromSlot, ReachDirection::Upstream);
+    ancestors.push_back(*fromSlot);
+    auto descendants = reachableSlots(*toSlot, ReachDirection::Downstream);
+    descendants.push_back(*toSlot);
+    refreshReach(wasValid, ancestors, descendants);
+}
+
+// A task's own duration feeds its remaining work and its dependents'
+// earliest starts
+void refreshCpmAfterTaskEdit(bool wasValid, int taskId) {
+    if (!wasValid) {
+        return;
+    }
+    auto dependents = taskIds(db::getCpmDependents(taskId));
+    refreshCpm(wasValid, dependents, std::array{taskId});
+}
+}  // namespace
+
+namespace repo {
+core::BucketQueue loadUserTaskQueue() {
+    core::BucketQueue queue;
+    auto tasks = db::getReadyTasks();
 
     for (const auto &task : tasks) {
         queue.insert(task);
@@ -26,15 +258,29 @@ core::Queue loadUserTaskQueue() {
 }
 
 void getNextPriorityTask() {
-    auto queue = loadUserTaskQueue();
-    auto taskOpt = queue.extractMin();
+    auto version = db::getTasksVersion();
+    auto snapshot = db::getQueueSnapshot(version);
+
+    if (!snapshot.has_value()) {
+        auto queue = loadUserTaskQueue();
+        std::vector<Task> top;
+        while (top.size() < NEXT_SNAPSHOT_SIZE) {
+            auto taskOpt = queue.extractMin();
+            if (!taskOpt.has_value()) {
+                break;
+            }
+            top.emplace_back(std::move(taskOpt.value()));
+        }
+        db::saveQueueSnapshot(version, top);
+        snapshot = std::move(top);
+    }
 
-    if (!taskOpt.has_value()) {
+    if (snapshot->empty()) {
         std::println("No incomplete tasks found.");
         return;
     }
 
-    Task task = taskOpt.value();
+    const Task &task = snapshot->front();
     tabulate::Table table;
     table.add_row({"ID", "Title", "Priority", "Status", "Due Date"});
     table.add_row(tabulate::RowStream{}
@@ -43,13 +289,6 @@ void getNextPriorityTask() {
     printStyledTable(table);
 }
 
-std::vector<Task> getSortedTasks(bool (*comparator)(const Task &,
-                                                    const Task &)) {
-    auto tasks = db::getTasksByUser();
-    core::mergeSort(tasks, comparator);
-    return tasks;
-}
-
 void showTask(int taskId) {
     auto optional = db::getTask(taskId);
 
@@ -86,8 +325,67 @@ void showAllTasks() {
     printStyledTable(table);
 }
 
+// Streams the listing through an external sort so neither the rows nor the
+// table are held in memory; rows are printed as plain aligned lines.
+static void listTasksExternal(bool showAll, int filterStatus,
+                              int filterPriority, const core::SortSpec &spec,
+                              int memoryBudgetMb) {
+    core::ExternalSorter sorter(
+        spec, static_cast<std::size_t>(memoryBudgetMb) * 1024 * 1024);
+
+    // add() spills runs to disk as the budget fills, so it can throw on
+    // I/O errors just like finish()
+    std::size_t count = 0;
+    try {
+        bool ok = db::forEachTask(showAll, [&](Task &&task) {
+            if (filterStatus >= 0 && task.status != filterStatus) {
+                return;
+            }
+            if (filterPriority >= 0 && task.priority != filterPriority) {
+                return;
+            }
+            sorter.add(std::move(task));
+        });
+        if (!ok) {
+            return;
+        }
+
+        sorter.finish([&count](const Task &task) {
+            if (count++ == 0) {
+                std::println("{:<8} {:<40} {:<8} {:<12} {}", "ID", "Title",
+                             "Priority", "Status", "Due Date");
+            }
+            std::println("{:<8} {:<40} {:<8} {:<12} {}", task.id, task.title,
+                         task.priority, statusToString(task.status),
+                         formatDate(task.dueDate));
+        });
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return;
+    }
+
+    if (count == 0) {
+        std::println("No tasks found.");
+    }
+}
+
 void listTasks(bool showAll, int filterStatus, int filterPriority,
-               const std::string &sortBy) {
+               const std::string &sortBy, int memoryBudgetMb) {
+    auto spec = core::parseSortSpec(sortBy);
+    if (!spec.has_value()) {
+        std::println(
+            "Invalid sort \"{}\". Use a comma-separated list of: priority, "
+            "due, created, status, title (prefix '-' for descending).",
+            sortBy);
+        return;
+    }
+
+    if (memoryBudgetMb > 0) {
+        listTasksExternal(showAll, filterStatus, filterPriority, spec.value(),
+                          memoryBudgetMb);
+        return;
+    }
+
     std::vector<Task> tasks;
 
     // Get base task list
@@ -111,14 +409,6 @@ void listTasks(bool showAll, int filterStatus, int filterPriority,
         });
     }
 
-    if (sortBy == "priority") {
-        core::mergeSort(tasks, core::byPriority);
-    } else if (sortBy == "date") {
-        core::mergeSort(tasks, core::byDueDate);
-    } else if (sortBy == "created") {
-        core::mergeSort(tasks, core::byId);
-    }
-
     if (tasks.empty()) {
         std::println("No tasks found.");
         return;
@@ -127,11 +417,18 @@ void listTasks(bool showAll, int filterStatus, int filterPriority,
     tabulate::Table table;
     table.add_row({"ID", "Title", "Priority", "Status", "Due Date"});
 
-    for (const auto &task : tasks) {
+    auto addRow = [&table](const Task &task) {
         table.add_row(tabulate::RowStream{} << task.id << task.title
                                             << task.priority
                                             << statusToString(task.status)
                                             << formatDate(task.dueDate));
+    };
+
+    // Fetching unordered and sorting here beats an SQL ORDER BY, which has
+    // no index to use and sorts the full rows. Rows are rendered through
+    // the sorted index order and never moved.
+    for (auto index : core::sortedOrder(tasks, spec.value())) {
+        addRow(tasks[index]);
     }
     printStyledTable(table);
 }
@@ -169,8 +466,11 @@ void updateTaskStatus(int taskId, int status) {
         return;
     }
 
+    // Finished tasks count as zero hours on the critical path
+    bool cpmValid = db::isCpmValid();
     if (db::updateTaskStatus(taskId, status)) {
         std::println("Updated task {} status.", taskId);
+        refreshCpmAfterTaskEdit(cpmValid, taskId);
     } else {
         std::println("Failed to update task status.");
     }
@@ -209,6 +509,28 @@ void updateTaskTitle(int taskId, const std::string &title) {
     }
 }
 
+void updateTaskEstimate(int taskId, int estimate) {
+    auto task = db::getTask(taskId);
+    if (!task.has_value()) {
+        std::println("No task with id {}.", taskId);
+        return;
+    }
+
+    if (estimate < 0) {
+        std::println("Estimate cannot be negative.");
+        return;
+    }
+
+    bool cpmValid = db::isCpmValid();
+    if (db::updateTaskEstimate(taskId, estimate)) {
+        std::println("Updated task {} estimate to {} hours.", taskId,
+                     estimate);
+        refreshCpmAfterTaskEdit(cpmValid, taskId);
+    } else {
+        std::println("Failed to update task estimate.");
+    }
+}
+
 void deleteTask(int taskId) {
     auto task = db::getTask(taskId);
     if (!task.has_value()) {
@@ -216,10 +538,484 @@ void deleteTask(int taskId) {
         return;
     }
 
+    // The delete cascades to the task's edges, so collect its neighbours
+    // first; they are what the removal changes
+    bool cpmValid = db::isCpmValid();
+    auto dependents = taskIds(db::getCpmDependents(taskId));
+    auto prerequisites = taskIds(db::getCpmPrerequisites(taskId));
+    bool reachValid = db::isReachValid();
+    std::vector<std::uint32_t> upstream;
+    std::vector<std::uint32_t> downstream;
+    if (auto slot = db::getReachSlot(taskId)) {
+        upstream = reachableSlots(*slot, ReachDirection::Upstream);
+        downstream = reachableSlots(*slot, ReachDirection::Downstream);
+    }
+
     if (db::deleteTask(taskId)) {
         std::println("Deleted task {}.", taskId);
+        refreshCpm(cpmValid, dependents, prerequisites);
+        // Only the task's ancestors and descendants held its slot
+        refreshReach(reachValid, upstream, downstream);
     } else {
         std::println("Failed to delete task.");
     }
 }
-}  // namespace repo
\ No newline at end of file
+
+void addDependency(int taskId, int dependsOn) {
+    for (int id : {taskId, dependsOn}) {
+        if (!db::getTask(id).has_value()) {
+            std::println("No task with id {}.", id);
+            return;
+        }
+    }
+
+    if (taskId == dependsOn) {
+        std::println("A task cannot depend on itself.");
+        return;
+    }
+    if (db::hasDependency(taskId, dependsOn)) {
+        std::println("Task {} already depends on task {}.", taskId, dependsOn);
+        return;
+    }
+
+    if (!db::isTopoRanked() && !rankExistingDependencies()) {
+        return;
+    }
+
+    // A task gaining its first edge goes at one end of the order: a new
+    // prerequisite before every ranked task, a new dependent after them.
+    auto [low, high] = db::getTopoRankRange().value_or(
+        std::pair<std::int64_t, std::int64_t>{0, 0});
+    std::vector<TopoRank> ranks;
+    TopoRank from{dependsOn, low - 1};
+    TopoRank to{taskId, high + 1};
+    if (auto rank = db::getTopoRank(dependsOn)) {
+        from.rank = *rank;
+    } else {
+        ranks.push_back(from);
+    }
+    if (auto rank = db::getTopoRank(taskId)) {
+        to.rank = *rank;
+    } else {
+        ranks.push_back(to);
+    }
+
+    core::RankedNeighbours neighbours{db::getDependentsRankedUpTo,
+                                      db::getPrerequisitesRankedFrom};
+    auto moved = core::reorderForEdge(from, to, neighbours);
+    if (!moved.has_value()) {
+        std::println(
+            "Cannot add: task {} already depends on task {}, so this would "
+            "create a cycle.",
+            dependsOn, taskId);
+        return;
+    }
+    ranks.insert(ranks.end(), moved->begin(), moved->end());
+
+    bool cpmValid = db::isCpmValid();
+    bool reachValid = db::isReachValid();
+    if (db::addDependency(taskId, dependsOn, ranks)) {
+        std::println("Task {} now depends on task {}.", taskId, dependsOn);
+        refreshCpm(cpmValid, std::array{taskId}, std::array{dependsOn});
+        refreshReachAfterAdd(reachValid, dependsOn, taskId);
+    } else {
+        std::println("Failed to add dependency.");
+    }
+}
+
+void removeDependency(int taskId, int dependsOn) {
+    if (!db::hasDependency(taskId, dependsOn)) {
+        std::println("Task {} does not depend on task {}.", taskId, dependsOn);
+        return;
+    }
+
+    bool cpmValid = db::isCpmValid();
+    bool reachValid = db::isReachValid();
+    if (db::removeDependency(taskId, dependsOn)) {
+        std::println("Task {} no longer depends on task {}.", taskId,
+                     dependsOn);
+        refreshCpm(cpmValid, std::array{taskId}, std::array{dependsOn});
+        refreshReachAfterRemove(reachValid, dependsOn, taskId);
+    } else {
+        std::println("Failed to remove dependency.");
+    }
+}
+
+void showDependencies(int taskId, int depth, const std::string &direction) {
+    if (depth < 1) {
+        std::println("Depth must be at least 1.");
+        return;
+    }
+    bool up = direction == "up" || direction == "both";
+    bool down = direction == "down" || direction == "both";
+    if (!up && !down) {
+        std::println("Invalid direction. Use up, down, or both.");
+        return;
+    }
+    if (!db::getTask(taskId).has_value()) {
+        std::println("No task with id {}.", taskId);
+        return;
+    }
+
+    // Beyond direct neighbours, rows carry how many edges away they are
+    auto print = [depth](const std::vector<TaskAtDepth> &found) {
+        if (depth > 1) {
+            printTasksAtDepth(found);
+            return;
+        }
+        std::vector<Task> tasks;
+        tasks.reserve(found.size());
+        for (const auto &entry : found) {
+            tasks.push_back(entry.task);
+        }
+        printTasks(tasks);
+    };
+
+    if (up) {
+        auto prerequisites =
+            db::getNeighbourhood(taskId, ReachDirection::Upstream, depth);
+        if (prerequisites.empty()) {
+            std::println("Task {} depends on no tasks.", taskId);
+        } else {
+            std::println("Task {} depends on:", taskId);
+            print(prerequisites);
+        }
+    }
+
+    if (down) {
+        auto dependents =
+            db::getNeighbourhood(taskId, ReachDirection::Downstream, depth);
+        if (dependents.empty()) {
+            std::println("No tasks depend on task {}.", taskId);
+        } else {
+            std::println("Tasks that depend on task {}:", taskId);
+            print(dependents);
+        }
+    }
+}
+
+void exportDependencies(const std::string &format, const std::string &path,
+                        const std::vector<int> &roots,
+                        const std::string &direction) {
+    auto exportFormat = core::parseExportFormat(format);
+    if (!exportFormat.has_value()) {
+        std::println("Invalid format. Use dot, graphml, or jsonl.");
+        return;
+    }
+    bool up = direction == "up" || direction == "both";
+    bool down = direction == "down" || direction == "both";
+    if (!up && !down) {
+        std::println("Invalid direction. Use up, down, or both.");
+        return;
+    }
+    for (int root : roots) {
+        if (!db::getTask(root).has_value()) {
+            std::println("No task with id {}.", root);
+            return;
+        }
+    }
+
+    std::size_t taskCount = 0;
+    std::size_t edgeCount = 0;
+    try {
+        core::GraphExporter exporter(path, *exportFormat);
+        bool ok = db::forEachInGraph(
+            roots, up, down,
+            [&](Task &&task) {
+                exporter.writeTask(task);
+                taskCount++;
+            },
+            [&](Dependency dependency) {
+                exporter.writeDependency(dependency);
+                edgeCount++;
+            });
+        if (!ok) {
+            return;
+        }
+        exporter.finish();
+    } catch (const std::exception &e) {
+        std::println("{}\n", e.what());
+        return;
+    }
+
+    std::println("Exported {} tasks and {} dependencies to {}.", taskCount,
+                 edgeCount, path);
+}
+
+void reduceDependencies(bool apply) {
+    auto edges = db::getDependencies();
+    auto graph = core::DependencyGraph::fromEdges(edges);
+    auto redundant = core::redundantEdges(graph);
+    if (!redundant.has_value()) {
+        std::println("Dependency cycle detected; cannot reduce.");
+        return;
+    }
+    if (redundant->empty()) {
+        std::println("No redundant dependencies among {} edges.",
+                     edges.size());
+        return;
+    }
+
+    tabulate::Table table;
+    table.add_row({"", "Task", "Depends On"});
+    for (const auto &edge : *redundant) {
+        table.add_row(tabulate::RowStream{}
+                      << "-" << edge.taskId << edge.dependsOn);
+    }
+    printStyledTable(table);
+
+    if (!apply) {
+        std::println(
+            "{} of {} dependencies are implied by longer chains. Run with "
+            "--apply to remove them.",
+            redundant->size(), edges.size());
+        return;
+    }
+    if (db::removeRedundantDependencies(*redundant)) {
+        std::println("Removed {} redundant dependencies.", redundant->size());
+    } else {
+        std::println("Failed to remove redundant dependencies.");
+    }
+}
+
+void checkDependencies() {
+    auto edges = db::getDependencies();
+    auto graph = core::DependencyGraph::fromEdges(edges);
+    auto components = graph.cyclicComponents();
+    if (components.empty()) {
+        std::println("No cycles among {} dependencies.", edges.size());
+        return;
+    }
+
+    // Long lists are cut short; the count says how many were left out
+    auto joinIds = [&graph](std::span<const std::uint32_t> vertices,
+                            const char *separator) {
+        std::string text;
+        std::size_t shown = std::min(vertices.size(), CHECK_LIST_LIMIT);
+        for (std::size_t i = 0; i < shown; i++) {
+            text += std::format("{}{}", i > 0 ? separator : "",
+                                graph.taskIdAt(vertices[i]));
+        }
+        if (shown < vertices.size()) {
+            text += std::format(" (+{} more)", vertices.size() - shown);
+        }
+        return text;
+    };
+
+    tabulate::Table table;
+    table.add_row({"Component", "Size", "Tasks", "Example Cycle"});
+    std::size_t taskCount = 0;
+    for (std::size_t i = 0; i < components.size(); i++) {
+        const auto &component = components[i];
+        auto cycle = graph.shortestCycle(component);
+        table.add_row(tabulate::RowStream{}
+                      << i + 1 << component.size() << joinIds(component, ", ")
+                      << joinIds(cycle, " -> "));
+        taskCount += component.size();
+    }
+    printStyledTable(table);
+    std::println(
+        "{} cyclic components covering {} tasks. In each example cycle, a "
+        "task must finish before the next one.",
+        components.size(), taskCount);
+}
+
+void showExecutionPlan() {
+    auto open = loadOpenGraph();
+    if (open.tasks.empty()) {
+        std::println("No incomplete tasks found.");
+        return;
+    }
+
+    auto waves = open.graph.waves(core::ThreadPool::shared());
+    if (!waves.has_value()) {
+        std::println("Dependencies contain a cycle; no plan is possible.");
+        return;
+    }
+
+    // Tasks within a wave are independent; list the most urgent first, with
+    // vertex order (task ids) settling the remaining ties
+    auto byUrgency = [&open](std::uint32_t a, std::uint32_t b) {
+        const Task &left = *open.byVertex[a];
+        const Task &right = *open.byVertex[b];
+        if (core::Queue::isHigherPriority(left, right)) {
+            return true;
+        }
+        return !core::Queue::isHigherPriority(right, left) && a < b;
+    };
+
+    tabulate::Table table;
+    table.add_row({"Wave", "ID", "Title", "Priority", "Due Date"});
+    for (std::size_t wave = 0; wave < waves->size(); wave++) {
+        auto &vertices = (*waves)[wave];
+        std::sort(vertices.begin(), vertices.end(), byUrgency);
+        for (auto vertex : vertices) {
+            const Task &task = *open.byVertex[vertex];
+            table.add_row(tabulate::RowStream{}
+                          << wave + 1 << task.id << task.title
+                          << task.priority << formatDate(task.dueDate));
+        }
+    }
+    printStyledTable(table);
+    std::println("{} tasks in {} waves; tasks in the same wave can run "
+                 "concurrently.",
+                 open.tasks.size(), waves->size());
+}
+
+void showCriticalPath(bool showAll) {
+    if (!db::isTopoRanked() && !rankExistingDependencies()) {
+        return;
+    }
+    if (!db::isCpmValid() && !rebuildCpm()) {
+        return;
+    }
+
+    auto nodes = db::getCpmTasks();
+    std::int64_t length = 0;
+    for (const auto &[task, node] : nodes) {
+        length = std::max(length, node.earliestStart + node.remaining);
+    }
+
+    tabulate::Table table;
+    table.add_row({"ID", "Title", "Estimate", "Earliest Start",
+                   "Latest Start", "Slack"});
+    std::size_t rows = 0;
+    for (const auto &[task, node] : nodes) {
+        std::int64_t latestStart = length - node.remaining;
+        std::int64_t slack = latestStart - node.earliestStart;
+        if (!showAll && slack != 0) {
+            continue;
+        }
+
+        if (task.status == static_cast<int>(TaskStatus::COMPLETE) ||
+            task.status == static_cast<int>(TaskStatus::WONT_DO)) {
+            continue;
+        }
+        table.add_row(tabulate::RowStream{}
+                      << task.id << task.title << task.estimate
+                      << node.earliestStart << latestStart << slack);
+        rows++;
+    }
+
+    if (rows == 0) {
+        std::println("No dependencies between incomplete tasks.");
+        return;
+    }
+    printStyledTable(table);
+    std::println("Project length: {} hours. Times are in hours from now.",
+                 length);
+}
+
+void showSchedule(int workers) {
+    if (workers < 1) {
+        std::println("Workers must be at least 1.");
+        return;
+    }
+    auto open = loadOpenGraph();
+    if (open.tasks.empty()) {
+        std::println("No incomplete tasks found.");
+        return;
+    }
+
+    std::vector<std::int64_t> durations;
+    std::vector<int> priorities;
+    durations.reserve(open.byVertex.size());
+    priorities.reserve(open.byVertex.size());
+    std::int64_t totalWork = 0;
+    for (const Task *task : open.byVertex) {
+        durations.push_back(task->estimate);
+        priorities.push_back(task->priority);
+        totalWork += task->estimate;
+    }
+
+    auto schedule =
+        core::scheduleWork(open.graph, durations, priorities, workers);
+    if (!schedule.has_value()) {
+        std::println("Dependency cycle detected; cannot schedule.");
+        return;
+    }
+
+    // Assignments come in start order, so a stable sort by worker leaves
+    // each worker's timeline in order
+    std::stable_sort(schedule->assignments.begin(),
+                     schedule->assignments.end(),
+                     [](const auto &a, const auto &b) {
+                         return a.worker < b.worker;
+                     });
+    int currentWorker = -1;
+    for (const auto &assignment : schedule->assignments) {
+        if (assignment.worker != currentWorker) {
+            currentWorker = assignment.worker;
+            std::println("{}Worker {}", currentWorker == 0 ? "" : "\n",
+                         currentWorker + 1);
+            std::println("{:<8} {:<8} {:<8} {}", "Start", "End", "ID",
+                         "Title");
+        }
+        const Task *task = open.byVertex[assignment.vertex];
+        std::println("{:<8} {:<8} {:<8} {}", assignment.start,
+                     assignment.finish, task->id, task->title);
+    }
+
+    std::println(
+        "\nMakespan: {} hours with {} workers. Critical path: {} hours; total "
+        "work: {} hours.",
+        schedule->makespan, workers, schedule->criticalPath, totalWork);
+}
+
+void showBlockers(int taskId, int otherId) {
+    if (!db::getTask(taskId).has_value()) {
+        std::println("No task with id {}.", taskId);
+        return;
+    }
+    if (otherId != 0 && !db::getTask(otherId).has_value()) {
+        std::println("No task with id {}.", otherId);
+        return;
+    }
+    if (!ensureReachIndex()) {
+        return;
+    }
+
+    if (otherId != 0) {
+        auto blocked = db::isReachable(otherId, taskId);
+        if (!blocked.has_value()) {
+            return;
+        }
+        std::println("Task {} is {}blocked by task {}.", taskId,
+                     *blocked ? "" : "not ", otherId);
+        return;
+    }
+
+    auto slot = db::getReachSlot(taskId);
+    auto tasks = db::getTasksBySlots(
+        slot ? reachableSlots(*slot, ReachDirection::Upstream)
+             : std::vector<std::uint32_t>{});
+    if (tasks.empty()) {
+        std::println("Task {} is not blocked by any task.", taskId);
+        return;
+    }
+    std::println("Task {} is blocked, directly or transitively, by:", taskId);
+    printTasks(tasks);
+}
+
+void showDownstream(int taskId) {
+    if (!db::getTask(taskId).has_value()) {
+        std::println("No task with id {}.", taskId);
+        return;
+    }
+    if (!ensureReachIndex()) {
+        return;
+    }
+
+    auto slot = db::getReachSlot(taskId);
+    auto tasks = db::getTasksBySlots(
+        slot ? reachableSlots(*slot, ReachDirection::Downstream)
+             : std::vector<std::uint32_t>{});
+    if (tasks.empty()) {
+        std::println("No tasks wait on task {}.", taskId);
+        return;
+    }
+    std::println("Tasks waiting, directly or transitively, on task {}:",
+                 taskId);
+    printTasks(tasks);
+}
+}  // namespace repo
@@ -0,0 +1,304 @@
+#include "simdSort.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CASCADE_HAS_AVX2_KERNELS 1
+#endif
+
+namespace {
+constexpr std::size_t BLOCK = 16;
+constexpr std::size_t LANES = 4;
+// Ranges up to this size skip the radix passes and go to the leaf sort
+constexpr std::size_t LEAF_SIZE = 256;
+// Whole inputs smaller than this are sorted by std::sort
+constexpr std::size_t SMALL_INPUT = 2048;
+constexpr std::size_t RADIX_BUCKETS = 256;
+
+void insertionSort(std::span<std::uint64_t> values) {
+    for (std::size_t i = 1; i < values.size(); i++) {
+        std::uint64_t value = values[i];
+        std::size_t j = i;
+        for (; j > 0 && values[j - 1] > value; j--) {
+            values[j] = values[j - 1];
+        }
+        values[j] = value;
+    }
+}
+
+// Branchless two-way merge; values are unique, so ties cannot occur.
+void scalarMerge(const std::uint64_t* a, std::size_t aSize,
+                 const std::uint64_t* b, std::size_t bSize,
+                 std::uint64_t* out) {
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < aSize && j < bSize) {
+        std::uint64_t x = a[i];
+        std::uint64_t y = b[j];
+        bool takeB = y < x;
+        *out++ = takeB ? y : x;
+        i += !takeB;
+        j += takeB;
+    }
+    out = std::copy(a + i, a + aSize, out);
+    std::copy(b + j, b + bSize, out);
+}
+
+#ifdef CASCADE_HAS_AVX2_KERNELS
+// AVX2 only compares signed 64-bit lanes; biasing both sides by the sign bit
+// turns that into an unsigned comparison.
+__attribute__((target("avx2"))) inline void minMax(__m256i& low,
+                                                    __m256i& high) {
+    const __m256i bias = _mm256_set1_epi64x(INT64_MIN);
+    __m256i greater = _mm256_cmpgt_epi64(_mm256_xor_si256(low, bias),
+                                         _mm256_xor_si256(high, bias));
+    __m256i min = _mm256_blendv_epi8(low, high, greater);
+    high = _mm256_blendv_epi8(high, low, greater);
+    low = min;
+}
+
+__attribute__((target("avx2"))) inline __m256i reverse(__m256i v) {
+    return _mm256_permute4x64_epi64(v, 0x1B);
+}
+
+__attribute__((target("avx2"))) inline __m256i loadLanes(
+    const std::uint64_t* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+__attribute__((target("avx2"))) inline void storeLanes(std::uint64_t* p,
+                                                        __m256i v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+
+// Sorts a bitonic 4-lane vector: compare lanes 2 apart, then 1 apart.
+__attribute__((target("avx2"))) inline void bitonicClean(__m256i& v) {
+    __m256i swapped = _mm256_permute4x64_epi64(v, 0x4E);
+    __m256i low = v;
+    minMax(low, swapped);
+    v = _mm256_blend_epi32(low, swapped, 0xF0);
+
+    swapped = _mm256_permute4x64_epi64(v, 0xB1);
+    low = v;
+    minMax(low, swapped);
+    v = _mm256_blend_epi32(low, swapped, 0xCC);
+}
+
+// Merges two sorted vectors into a sorted 8-element sequence (a, b).
+__attribute__((target("avx2"))) inline void bitonicMerge4(__m256i& a,
+                                                           __m256i& b) {
+    b = reverse(b);
+    minMax(a, b);
+    bitonicClean(a);
+    bitonicClean(b);
+}
+
+__attribute__((target("avx2"))) void sortBlockAvx2(std::uint64_t* block) {
+    __m256i r0 = loadLanes(block);
+    __m256i r1 = loadLanes(block + LANES);
+    __m256i r2 = loadLanes(block + 2 * LANES);
+    __m256i r3 = loadLanes(block + 3 * LANES);
+
+    // Sorting network across registers sorts each of the 4 columns
+    minMax(r0, r1);
+    minMax(r2, r3);
+    minMax(r0, r2);
+    minMax(r1, r3);
+    minMax(r1, r2);
+
+    // Transpose so every register holds one sorted column
+    __m256i t0 = _mm256_unpacklo_epi64(r0, r1);
+    __m256i t1 = _mm256_unpackhi_epi64(r0, r1);
+    __m256i t2 = _mm256_unpacklo_epi64(r2, r3);
+    __m256i t3 = _mm256_unpackhi_epi64(r2, r3);
+    r0 = _mm256_permute2x128_si256(t0, t2, 0x20);
+    r1 = _mm256_permute2x128_si256(t1, t3, 0x20);
+    r2 = _mm256_permute2x128_si256(t0, t2, 0x31);
+    r3 = _mm256_permute2x128_si256(t1, t3, 0x31);
+
+    bitonicMerge4(r0, r1);
+    bitonicMerge4(r2, r3);
+
+    // Merge the two sorted 8-element halves (r0, r1) and (r2, r3)
+    __m256i reversed0 = reverse(r3);
+    __m256i reversed1 = reverse(r2);
+    minMax(r0, reversed0);
+    minMax(r1, reversed1);
+    minMax(r0, r1);
+    minMax(reversed0, reversed1);
+    bitonicClean(r0);
+    bitonicClean(r1);
+    bitonicClean(reversed0);
+    bitonicClean(reversed1);
+
+    storeLanes(block, r0);
+    storeLanes(block + LANES, r1);
+    storeLanes(block + 2 * LANES, reversed0);
+    storeLanes(block + 3 * LANES, reversed1);
+}
+
+// Merges runs whose lengths are multiples of 4, one vector at a time: the
+// lower half of each 8-element bitonic merge is final, the upper half is
+// carried into the next step against whichever run has the smaller head.
+__attribute__((target("avx2"))) void mergeAvx2(const std::uint64_t* a,
+                                               std::size_t aSize,
+                                               const std::uint64_t* b,
+                                               std::size_t bSize,
+                                               std::uint64_t* out) {
+    __m256i carry = loadLanes(a);
+    __m256i next = loadLanes(b);
+    std::size_t i = LANES;
+    std::size_t j = LANES;
+
+    while (true) {
+        bitonicMerge4(carry, next);
+        storeLanes(out, carry);
+        out += LANES;
+        carry = next;
+
+        if (i < aSize && (j >= bSize || a[i] < b[j])) {
+            next = loadLanes(a + i);
+            i += LANES;
+        } else if (j < bSize) {
+            next = loadLanes(b + j);
+            j += LANES;
+        } else {
+            break;
+        }
+    }
+    storeLanes(out, carry);
+}
+
+bool detectAvx2() { return __builtin_cpu_supports("avx2"); }
+#else
+bool detectAvx2() { return false; }
+#endif
+
+void sortBlockScalar(std::uint64_t* block) {
+    insertionSort(std::span<std::uint64_t>(block, BLOCK));
+}
+
+// Cleared by setSimdSortEnabled to force the scalar kernels
+bool simdEnabled = true;
+
+bool useAvx2() {
+    static const bool supported = detectAvx2();
+    return supported && simdEnabled;
+}
+
+void mergeRuns(const std::uint64_t* a, std::size_t aSize,
+               const std::uint64_t* b, std::size_t bSize, std::uint64_t* out) {
+#ifdef CASCADE_HAS_AVX2_KERNELS
+    if (useAvx2() && aSize > 0 && bSize > 0 && aSize % LANES == 0 &&
+        bSize % LANES == 0) {
+        mergeAvx2(a, aSize, b, bSize, out);
+        return;
+    }
+#endif
+    scalarMerge(a, aSize, b, bSize, out);
+}
+
+// Sorts up to a few hundred values: 16-element blocks through the network,
+// then pairwise merges ping-ponging between data and scratch.
+void leafSort(std::uint64_t* data, std::uint64_t* scratch, std::size_t n) {
+    auto sortBlock = sortBlockScalar;
+#ifdef CASCADE_HAS_AVX2_KERNELS
+    if (useAvx2()) {
+        sortBlock = sortBlockAvx2;
+    }
+#endif
+
+    std::size_t fullBlocks = n / BLOCK * BLOCK;
+    for (std::size_t start = 0; start < fullBlocks; start += BLOCK) {
+        sortBlock(data + start);
+    }
+    insertionSort(std::span<std::uint64_t>(data + fullBlocks, n - fullBlocks));
+
+    std::uint64_t* source = data;
+    std::uint64_t* target = scratch;
+    for (std::size_t width = BLOCK; width < n; width *= 2) {
+        for (std::size_t low = 0; low < n; low += 2 * width) {
+            std::size_t mid = std::min(n, low + width);
+            std::size_t high = std::min(n, low + 2 * width);
+            mergeRuns(source + low, mid - low, source + mid, high - mid,
+                      target + low);
+        }
+        std::swap(source, target);
+    }
+
+    if (source != data) {
+        std::copy(source, source + n, data);
+    }
+}
+
+// MSD radix sort on one byte at a time from the top, skipping bytes that
+// are constant within the range; buckets small enough are finished by the
+// SIMD leaf sort. Scattering is stable, so buckets stay in input order.
+void radixSort(std::uint64_t* data, std::uint64_t* scratch, std::size_t n,
+               int byte) {
+    if (n <= LEAF_SIZE) {
+        leafSort(data, scratch, n);
+        return;
+    }
+    if (std::is_sorted(data, data + n)) {
+        return;
+    }
+
+    for (; byte >= 0; byte--) {
+        int shift = byte * 8;
+        std::array<std::size_t, RADIX_BUCKETS> counts{};
+        for (std::size_t i = 0; i < n; i++) {
+            counts[(data[i] >> shift) & 0xFF]++;
+        }
+        if (counts[(data[0] >> shift) & 0xFF] == n) {
+            continue;
+        }
+
+        std::array<std::size_t, RADIX_BUCKETS> offsets;
+        std::size_t offset = 0;
+        for (std::size_t bucket = 0; bucket < RADIX_BUCKETS; bucket++) {
+            offsets[bucket] = offset;
+            offset += counts[bucket];
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            scratch[offsets[(data[i] >> shift) & 0xFF]++] = data[i];
+        }
+        std::copy(scratch, scratch + n, data);
+
+        std::size_t start = 0;
+        for (std::size_t count : counts) {
+            if (count > 1) {
+                radixSort(data + start, scratch + start, count, byte - 1);
+            }
+            start += count;
+        }
+        return;
+    }
+}
+}  // namespace
+
+bool core::hasSimdSort() { return useAvx2(); }
+
+void core::setSimdSortEnabled(bool enabled) { simdEnabled = enabled; }
+
+void core::sortPacked(std::span<std::uint64_t> values) {
+    if (values.size() <= 1) {
+        return;
+    }
+
+    // Below this, std::sort beats the radix passes and leaf merges
+    // (bench_simd_sort). Values are unique, so the order is the same.
+    if (values.size() < SMALL_INPUT) {
+        std::sort(values.begin(), values.end());
+        return;
+    }
+
+    std::vector<std::uint64_t> scratch(values.size());
+    radixSort(values.data(), scratch.data(), values.size(), 7);
+}
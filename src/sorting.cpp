@@ -1,60 +1,88 @@
 #include "sorting.h"
 
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <utility>
 #include <vector>
 
 namespace core {
 
-static void merge(std::vector<Task>& tasks, int left, int mid, int right,
-                  bool (*comparator)(const Task&, const Task&),
-                  std::vector<Task>& temp) {
-    int i = left;
-    int j = mid + 1;
-    int k = left;
-
-    while (i <= mid && j <= right) {
-        if (!comparator(tasks[j], tasks[i])) {
-            temp[k++] = tasks[i++];
-        } else {
-            temp[k++] = tasks[j++];
-        }
-    }
+namespace {
+constexpr int RADIX_BITS = 8;
+constexpr std::size_t RADIX_BUCKETS = 1 << RADIX_BITS;
+constexpr int RADIX_PASSES = 64 / RADIX_BITS;
+}  // namespace
 
-    while (i <= mid) {
-        temp[k++] = tasks[i++];
+std::vector<std::uint32_t> radixSortPermutation(
+    std::span<const std::vector<std::uint64_t>> columns, std::size_t n) {
+    std::vector<std::uint32_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    if (n <= 1) {
+        return order;
     }
 
-    while (j <= right) {
-        temp[k++] = tasks[j++];
+    // Rows often arrive already ordered (ids in rowid order); detect that
+    // in one scan instead of running every pass.
+    auto rowLess = [&columns](std::size_t a, std::size_t b) {
+        for (const auto& keys : columns) {
+            if (keys[a] != keys[b]) {
+                return keys[a] < keys[b];
+            }
+        }
+        return false;
+    };
+    bool presorted = true;
+    for (std::size_t i = 1; i < n && presorted; i++) {
+        presorted = !rowLess(i, i - 1);
     }
-
-    for (i = left; i <= right; i++) {
-        tasks[i] = temp[i];
+    if (presorted) {
+        return order;
     }
-}
 
-static void mergeSortHelper(std::vector<Task>& tasks, int left, int right,
-                            bool (*comparator)(const Task&, const Task&),
-                            std::vector<Task>& temp) {
-    if (left >= right) {
-        return;
-    }
+    std::vector<std::uint32_t> scratch(n);
 
-    int mid = left + (right - left) / 2;
+    // Least significant column first; each pass is stable, so earlier
+    // passes decide ties left by later ones.
+    for (auto column = columns.rbegin(); column != columns.rend(); ++column) {
+        const auto& keys = *column;
 
-    mergeSortHelper(tasks, left, mid, comparator, temp);
-    mergeSortHelper(tasks, mid + 1, right, comparator, temp);
-    merge(tasks, left, mid, right, comparator, temp);
-}
+        // One read of the keys yields the histograms for every byte
+        std::array<std::array<std::size_t, RADIX_BUCKETS>, RADIX_PASSES>
+            counts{};
+        for (std::uint64_t key : keys) {
+            for (int pass = 0; pass < RADIX_PASSES; pass++) {
+                counts[pass][(key >> (pass * RADIX_BITS)) & 0xFF]++;
+            }
+        }
 
-void mergeSort(std::vector<Task>& tasks,
-               bool (*comparator)(const Task&, const Task&)) {
-    if (tasks.size() <= 1) {
-        return;
+        for (int pass = 0; pass < RADIX_PASSES; pass++) {
+            int shift = pass * RADIX_BITS;
+            auto& count = counts[pass];
+
+            // Priorities and timestamps share most high bytes; a byte that
+            // is constant across all rows cannot reorder anything.
+            if (count[(keys[order[0]] >> shift) & 0xFF] == n) {
+                continue;
+            }
+
+            std::size_t offset = 0;
+            for (auto& bucket : count) {
+                offset += std::exchange(bucket, offset);
+            }
+            for (std::uint32_t index : order) {
+                scratch[count[(keys[index] >> shift) & 0xFF]++] = index;
+            }
+            order.swap(scratch);
+        }
     }
+    return order;
+}
 
-    std::vector<Task> temp(tasks.size());
-    mergeSortHelper(tasks, 0, static_cast<int>(tasks.size()) - 1, comparator,
-                    temp);
+void mergeSort(std::span<Task> tasks,
+               bool (*comparator)(const Task&, const Task&)) {
+    mergeSort<bool (*)(const Task&, const Task&)>(tasks, comparator);
 }
 
-}  // namespace core
\ No newline at end of file
+}  // namespace core
@@ -0,0 +1,257 @@
+#include "sortspec.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "ThreadPool.h"
+#include "collation.h"
+#include "models.h"
+#include "simdSort.h"
+#include "sorting.h"
+
+namespace core {
+
+namespace {
+struct FieldInfo {
+    std::string_view name;
+    SortField field;
+};
+
+constexpr FieldInfo FIELD_NAMES[] = {
+    {"priority", SortField::Priority}, {"due", SortField::DueDate},
+    {"date", SortField::DueDate},      {"created", SortField::Id},
+    {"id", SortField::Id},             {"status", SortField::Status},
+    {"title", SortField::Title},
+};
+
+template <class T>
+int threeWay(const T& a, const T& b) {
+    return (b < a) - (a < b);
+}
+
+int (*fieldComparison(SortField field))(const Task&, const Task&) {
+    switch (field) {
+        case SortField::Priority:
+            return [](const Task& a, const Task& b) {
+                return threeWay(a.priority, b.priority);
+            };
+        case SortField::DueDate:
+            return [](const Task& a, const Task& b) {
+                return threeWay(a.dueDate, b.dueDate);
+            };
+        case SortField::Id:
+            return [](const Task& a, const Task& b) {
+                return threeWay(a.id, b.id);
+            };
+        case SortField::Status:
+            return [](const Task& a, const Task& b) {
+                return threeWay(a.status, b.status);
+            };
+        case SortField::Title:
+            return [](const Task& a, const Task& b) {
+                return naturalCompare(a.title, b.title);
+            };
+    }
+    return nullptr;
+}
+
+std::int64_t integerField(const Task& task, SortField field) {
+    switch (field) {
+        case SortField::Priority:
+            return task.priority;
+        case SortField::DueDate:
+            return task.dueDate;
+        case SortField::Id:
+            return task.id;
+        case SortField::Status:
+            return task.status;
+        case SortField::Title:
+            break;
+    }
+    return 0;
+}
+
+// Signed values map to unsigned keys with the same order; descending keys
+// are complemented so the ascending radix sort reverses them.
+std::vector<std::uint64_t> keyColumn(std::span<const Task> tasks,
+                                     const SortKey& key) {
+    std::uint64_t flip = std::uint64_t{1} << 63;
+    if (key.descending) {
+        flip = ~flip;
+    }
+
+    std::vector<std::uint64_t> column(tasks.size());
+    for (std::size_t i = 0; i < tasks.size(); i++) {
+        column[i] =
+            static_cast<std::uint64_t>(integerField(tasks[i], key.field)) ^
+            flip;
+    }
+    return column;
+}
+// Concatenates the key columns, each shifted down to its minimum, into one
+// 32-bit key when their ranges fit, and pairs it with the row index. Ties in
+// the key then fall back to index order, which keeps the sort stable.
+std::optional<std::vector<std::uint64_t>> packKeys(
+    std::span<const std::vector<std::uint64_t>> columns, std::size_t n) {
+    std::vector<std::uint64_t> minimums;
+    std::vector<int> widths;
+    int totalWidth = 0;
+    for (const auto& column : columns) {
+        auto [low, high] = std::minmax_element(column.begin(), column.end());
+        int width = std::bit_width(*high - *low);
+        totalWidth += width;
+        if (totalWidth > 32) {
+            return std::nullopt;
+        }
+        minimums.push_back(*low);
+        widths.push_back(width);
+    }
+
+    std::vector<std::uint64_t> packed(n);
+    for (std::size_t i = 0; i < n; i++) {
+        std::uint64_t key = 0;
+        for (std::size_t c = 0; c < columns.size(); c++) {
+            key = (key << widths[c]) | (columns[c][i] - minimums[c]);
+        }
+        packed[i] = key << 32 | i;
+    }
+    return packed;
+}
+}  // namespace
+
+std::optional<SortSpec> parseSortSpec(std::string_view text) {
+    SortSpec spec;
+    if (text.empty()) {
+        return spec;
+    }
+
+    while (true) {
+        auto comma = text.find(',');
+        std::string_view term = text.substr(0, comma);
+
+        SortKey key{SortField::Id};
+        if (term.starts_with('-')) {
+            key.descending = true;
+            term.remove_prefix(1);
+        } else if (term.starts_with('+')) {
+            term.remove_prefix(1);
+        }
+
+        bool known = false;
+        for (const auto& info : FIELD_NAMES) {
+            if (info.name == term) {
+                key.field = info.field;
+                known = true;
+                break;
+            }
+        }
+        if (!known) {
+            return std::nullopt;
+        }
+        spec.keys.push_back(key);
+
+        if (comma == std::string_view::npos) {
+            return spec;
+        }
+        text.remove_prefix(comma + 1);
+    }
+}
+
+bool hasIntegerKeys(const SortSpec& spec) {
+    for (const auto& key : spec.keys) {
+        if (key.field == SortField::Title) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SortComparator::SortComparator(const SortSpec& spec) {
+    for (const auto& key : spec.keys) {
+        steps.push_back({fieldComparison(key.field), key.descending});
+    }
+}
+
+namespace {
+// Without a pool the title path sorts on the calling thread
+std::vector<std::uint32_t> orderRows(std::span<const Task> tasks,
+                                     const SortSpec& spec, ThreadPool* pool) {
+    if (spec.keys.empty() || tasks.size() <= 1) {
+        std::vector<std::uint32_t> order(tasks.size());
+        std::iota(order.begin(), order.end(), 0);
+        return order;
+    }
+
+    if (hasIntegerKeys(spec)) {
+        std::vector<std::vector<std::uint64_t>> columns;
+        for (const auto& key : spec.keys) {
+            columns.emplace_back(keyColumn(tasks, key));
+        }
+
+        // Priorities, statuses and date ranges of a real task list usually
+        // pack into one key, sorted by the SIMD-leaf radix sort.
+        if (auto packed = packKeys(columns, tasks.size())) {
+            sortPacked(*packed);
+            std::vector<std::uint32_t> order(tasks.size());
+            for (std::size_t i = 0; i < order.size(); i++) {
+                order[i] = static_cast<std::uint32_t>((*packed)[i]);
+            }
+            return order;
+        }
+        return radixSortPermutation(columns, tasks.size());
+    }
+
+    // Titles are collated once per row instead of on every comparison; a
+    // null step marks a title key.
+    TitleKeys titles(tasks);
+    std::vector<std::pair<int (*)(const Task&, const Task&), bool>> steps;
+    for (const auto& key : spec.keys) {
+        steps.emplace_back(key.field == SortField::Title
+                               ? nullptr
+                               : fieldComparison(key.field),
+                           key.descending);
+    }
+    auto byRow = [&](std::uint32_t a, std::uint32_t b) {
+        for (const auto& [compare, descending] : steps) {
+            int order = compare ? compare(tasks[a], tasks[b])
+                                : titles.compare(a, b);
+            if (order != 0) {
+                return descending ? order > 0 : order < 0;
+            }
+        }
+        return false;
+    };
+
+    std::vector<std::uint32_t> order(tasks.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (pool != nullptr) {
+        detail::parallelAdaptiveMergeSort(std::span<std::uint32_t>(order),
+                                          byRow, *pool);
+    } else {
+        detail::adaptiveMergeSort(std::span<std::uint32_t>(order), byRow);
+    }
+    return order;
+}
+}  // namespace
+
+std::vector<std::uint32_t> sortedOrder(std::span<const Task> tasks,
+                                       const SortSpec& spec, ThreadPool& pool) {
+    return orderRows(tasks, spec, &pool);
+}
+
+std::vector<std::uint32_t> sortedOrder(std::span<const Task> tasks,
+                                       const SortSpec& spec) {
+    // A pool with fewer than two grains of rows would sort sequentially
+    // anyway, so small lists never start the shared workers
+    bool large = tasks.size() >= 2 * detail::PARALLEL_GRAIN;
+    return orderRows(tasks, spec, large ? &ThreadPool::shared() : nullptr);
+}
+
+}  // namespace core
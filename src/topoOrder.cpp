@@ -0,0 +1,75 @@
+#include "topoOrder.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <unordered_set>
+#include <vector>
+
+#include "models.h"
+
+std::optional<std::vector<TopoRank>> core::reorderForEdge(
+    TopoRank from, TopoRank to, const RankedNeighbours& graph) {
+    if (from.rank < to.rank) {
+        return std::vector<TopoRank>{};
+    }
+
+    // Forward from `to` through tasks ranked at most from.rank. Reaching
+    // `from` itself means it already waits on `to`.
+    std::vector<TopoRank> forward{to};
+    std::unordered_set<int> seen{to.taskId};
+    for (std::size_t i = 0; i < forward.size(); i++) {
+        for (const auto& next :
+             graph.dependentsUpTo(forward[i].taskId, from.rank)) {
+            if (next.taskId == from.taskId) {
+                return std::nullopt;
+            }
+            if (seen.insert(next.taskId).second) {
+                forward.push_back(next);
+            }
+        }
+    }
+
+    // Backward from `from` through tasks ranked at least to.rank. The two
+    // searches cannot meet without the forward one having found `from`.
+    std::vector<TopoRank> backward{from};
+    for (std::size_t i = 0; i < backward.size(); i++) {
+        for (const auto& previous :
+             graph.prerequisitesFrom(backward[i].taskId, to.rank)) {
+            if (seen.insert(previous.taskId).second) {
+                backward.push_back(previous);
+            }
+        }
+    }
+
+    // The backward set moves ahead of the forward set; within each set the
+    // old relative order is kept, and the region reuses its own ranks.
+    auto byRank = [](const TopoRank& a, const TopoRank& b) {
+        return a.rank < b.rank;
+    };
+    std::sort(backward.begin(), backward.end(), byRank);
+    std::sort(forward.begin(), forward.end(), byRank);
+
+    std::vector<std::int64_t> ranks;
+    ranks.reserve(backward.size() + forward.size());
+    for (const auto& task : backward) {
+        ranks.push_back(task.rank);
+    }
+    for (const auto& task : forward) {
+        ranks.push_back(task.rank);
+    }
+    std::sort(ranks.begin(), ranks.end());
+
+    std::vector<TopoRank> updates;
+    updates.reserve(ranks.size());
+    std::size_t next = 0;
+    for (const auto* region : {&backward, &forward}) {
+        for (const auto& task : *region) {
+            if (ranks[next] != task.rank) {
+                updates.push_back({task.taskId, ranks[next]});
+            }
+            next++;
+        }
+    }
+    return updates;
+}
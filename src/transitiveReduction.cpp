@@ -0,0 +1,112 @@
+#include "transitiveReduction.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "DependencyGraph.h"
+#include "models.h"
+
+namespace {
+// Upper bound on the descendant bitsets held at once. A full V x V matrix
+// does not fit for large graphs, so target columns are handled one block at
+// a time, with the block as wide as this allows.
+constexpr std::size_t REDUCTION_BUDGET = 64 << 20;
+}  // namespace
+
+// Works in topological positions, where every edge p -> q has p < q. For a
+// block of target columns [first, last), a reverse sweep builds each row's
+// strict descendants within the block as the union of its successors' rows
+// plus the successors themselves. An edge p -> q is redundant exactly when
+// q is already in the union of p's successors' rows, i.e. some other
+// successor reaches q. Each edge is tested in the one block holding q.
+std::optional<std::vector<Dependency>> core::redundantEdges(
+    const DependencyGraph& graph) {
+    auto order = graph.topologicalOrder();
+    if (!order.has_value()) {
+        return std::nullopt;
+    }
+
+    std::size_t vertexCount = graph.getVertexCount();
+    std::vector<std::uint32_t> position(vertexCount);
+    for (std::uint32_t p = 0; p < vertexCount; p++) {
+        position[(*order)[p]] = p;
+    }
+
+    // Successors by position, in CSR form like the graph itself
+    std::vector<std::uint32_t> offsets(vertexCount + 1, 0);
+    std::vector<std::uint32_t> targets;
+    targets.reserve(graph.getEdgeCount());
+    for (std::uint32_t p = 0; p < vertexCount; p++) {
+        for (std::uint32_t next : graph.dependents((*order)[p])) {
+            targets.push_back(position[next]);
+        }
+        offsets[p + 1] = static_cast<std::uint32_t>(targets.size());
+    }
+
+    std::size_t totalWords = (vertexCount + 63) / 64;
+    std::size_t blockWords = std::clamp<std::size_t>(
+        REDUCTION_BUDGET / 8 / std::max<std::size_t>(vertexCount, 1), 1,
+        std::max<std::size_t>(totalWords, 1));
+    std::size_t blockBits = blockWords * 64;
+
+    std::vector<std::uint64_t> rows(vertexCount * blockWords);
+    std::vector<bool> nonEmpty(vertexCount);
+    std::vector<Dependency> redundant;
+
+    for (std::size_t first = 0; first < vertexCount; first += blockBits) {
+        std::size_t last = std::min(first + blockBits, vertexCount);
+        // Rows at or past `last` have no descendants in this block
+        std::fill_n(rows.begin(), last * blockWords, 0);
+        std::fill_n(nonEmpty.begin(), last, false);
+
+        for (std::size_t p = last; p-- > 0;) {
+            std::uint64_t* row = &rows[p * blockWords];
+            bool any = false;
+            for (std::uint32_t i = offsets[p]; i < offsets[p + 1]; i++) {
+                std::uint32_t q = targets[i];
+                if (q >= last || !nonEmpty[q]) {
+                    continue;
+                }
+                const std::uint64_t* from = &rows[q * blockWords];
+                for (std::size_t w = 0; w < blockWords; w++) {
+                    row[w] |= from[w];
+                }
+                any = true;
+            }
+
+            for (std::uint32_t i = offsets[p]; i < offsets[p + 1]; i++) {
+                std::uint32_t q = targets[i];
+                if (q < first || q >= last) {
+                    continue;
+                }
+                std::size_t bit = q - first;
+                std::uint64_t mask = std::uint64_t{1} << (bit % 64);
+                if (any && (row[bit / 64] & mask) != 0) {
+                    redundant.push_back({graph.taskIdAt((*order)[q]),
+                                         graph.taskIdAt((*order)[p])});
+                }
+            }
+            // Add the direct successors only after testing, so an edge is
+            // never implied by itself
+            for (std::uint32_t i = offsets[p]; i < offsets[p + 1]; i++) {
+                std::uint32_t q = targets[i];
+                if (q >= first && q < last) {
+                    std::size_t bit = q - first;
+                    row[bit / 64] |= std::uint64_t{1} << (bit % 64);
+                    any = true;
+                }
+            }
+            nonEmpty[p] = any;
+        }
+    }
+
+    std::sort(redundant.begin(), redundant.end(),
+              [](const Dependency& a, const Dependency& b) {
+                  return a.taskId != b.taskId ? a.taskId < b.taskId
+                                              : a.dependsOn < b.dependsOn;
+              });
+    return redundant;
+}